@@ -1,4 +1,5 @@
 #include "analyzer.h"
+#include "../extractor/scratch_arena.h"
 #include <cmath>
 #include <numeric>
 
@@ -11,12 +12,29 @@ Analyzer::~Analyzer() {
 }
 
 AnalysisResult Analyzer::analyze(const std::vector<Transaction>& transactions) {
+    // Working allocations come from the scratch arena; the result is copied out
+    ScratchScope scratch;
+
     AnalysisResult result;
-    result.totalIncome = 0.0;
-    result.totalExpenses = 0.0;
+
+    // Money moved between the ledger's own accounts is neither income nor spending
+    result.transfers = matchTransfers(transactions, transferOptions_);
+    std::vector<bool> transfer(transactions.size(), false);
+    for (const TransferPair& pair : result.transfers) {
+        transfer[pair.debit] = true;
+        transfer[pair.credit] = true;
+    }
 
     // Calculate totals by transaction type
-    for (const auto& txn : transactions) {
+    CurrencyCode currency = transactions.empty() ? kNoCurrency : transactions.front().amount.currency;
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        const Transaction& txn = transactions[i];
+        if (txn.amount.currency != currency) {
+            currency = kNoCurrency;
+        }
+        if (transfer[i]) {
+            continue;
+        }
         if (txn.type == "credit") {
             result.totalIncome += txn.amount;
         } else {
@@ -25,8 +43,13 @@ AnalysisResult Analyzer::analyze(const std::vector<Transaction>& transactions) {
     }
 
     result.netChange = result.totalIncome - result.totalExpenses;
+    result.totalIncome.currency = currency;
+    result.totalExpenses.currency = currency;
+    result.netChange.currency = currency;
+
+    result.recurring = detectRecurring(transactions);
 
-    return result;
+    return scratch.copyOut(result);
 }
 
 double Analyzer::calculateMean(const std::vector<double>& values) {
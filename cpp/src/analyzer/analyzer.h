@@ -1,17 +1,26 @@
 #pragma once
 #include "../extractor/transaction_extractor.h"
+#include "recurring_detector.h"
+#include "transfer_matcher.h"
 #include <vector>
 #include <map>
 #include <string>
 
 namespace BankAnalyzer {
 
+/**
+ * Totals are exact sums of the rows' minor units, tagged with the ledger's
+ * currency when every row agrees on one (kNoCurrency otherwise). Both sides
+ * of a transfer between the ledger's accounts are left out of them.
+ */
 struct AnalysisResult {
-    double totalIncome;
-    double totalExpenses;
-    double netChange;
-    std::map<std::string, double> categoryTotals;
+    Money totalIncome;
+    Money totalExpenses;
+    Money netChange;
+    std::map<std::string, Money> categoryTotals;
     std::vector<Transaction> anomalies;
+    std::vector<RecurringSeries> recurring;     // Subscriptions, bills, paycheques (see recurring_detector.h)
+    std::vector<TransferPair> transfers;        // Between the ledger's own accounts (see transfer_matcher.h)
 };
 
 class Analyzer {
@@ -26,9 +35,17 @@ public:
      */
     AnalysisResult analyze(const std::vector<Transaction>& transactions);
 
+    /**
+     * How far apart the two sides of a transfer may be dated
+     */
+    void setTransferOptions(const TransferOptions& options) { transferOptions_ = options; }
+    const TransferOptions& transferOptions() const { return transferOptions_; }
+
 private:
     double calculateMean(const std::vector<double>& values);
     double calculateStdDev(const std::vector<double>& values, double mean);
+
+    TransferOptions transferOptions_;
 };
 
 } // namespace BankAnalyzer
@@ -0,0 +1,113 @@
+#include "merchant_normalizer.h"
+#include <cctype>
+#include <vector>
+
+namespace BankAnalyzer {
+
+namespace {
+
+// Leading transaction-type phrases, each optionally followed by a connector
+// (same lists as extractMerchantName() in fuzzyMatch.ts)
+const std::vector<std::vector<std::string_view>> kTypePrefixes = {
+    {"purchase"}, {"payment"}, {"debit", "card"}, {"credit", "card"}, {"withdrawal"},
+    {"transfer"}, {"atm"}, {"pos"}, {"direct", "debit"},
+};
+const std::vector<std::string_view> kTypeConnectors = {"at", "to", "from", "for"};
+
+const std::vector<std::vector<std::string_view>> kChannelPrefixes = {
+    {"card", "payment"}, {"online", "payment"}, {"mobile", "payment"},
+};
+const std::vector<std::string_view> kChannelConnectors = {"to", "at"};
+
+const std::vector<std::string_view> kLocationWords = {"store", "loc", "location", "branch"};
+const std::vector<std::string_view> kCompanySuffixes = {"inc", "llc", "ltd", "corp", "corporation"};
+
+struct Token {
+    std::string text;       // Lower case, ASCII letters and digits only
+    bool hasDigit = false;
+};
+
+bool contains(const std::vector<std::string_view>& words, const std::string& word) {
+    for (std::string_view candidate : words) {
+        if (candidate == word) return true;
+    }
+    return false;
+}
+
+std::vector<Token> tokenize(std::string_view description) {
+    std::vector<Token> tokens;
+    Token current;
+    auto flush = [&] {
+        if (!current.text.empty()) {
+            tokens.push_back(std::move(current));
+        }
+        current = Token();
+    };
+    for (char c : description) {
+        unsigned char byte = static_cast<unsigned char>(c);
+        if (std::isspace(byte)) {
+            flush();
+        } else if (std::isalnum(byte)) {
+            current.text += static_cast<char>(std::tolower(byte));
+            current.hasDigit = current.hasDigit || std::isdigit(byte);
+        }
+        // Punctuation and non-ASCII bytes are dropped, like [^a-z0-9\s]
+    }
+    flush();
+    return tokens;
+}
+
+// Skip one of the phrases (and an optional connector) at tokens[pos]
+size_t skipPrefix(const std::vector<Token>& tokens, size_t pos,
+                  const std::vector<std::vector<std::string_view>>& phrases,
+                  const std::vector<std::string_view>& connectors) {
+    for (const auto& phrase : phrases) {
+        if (pos + phrase.size() >= tokens.size()) {
+            continue;       // The prefix must leave something behind it
+        }
+        bool same = true;
+        for (size_t i = 0; i < phrase.size() && same; ++i) {
+            same = tokens[pos + i].text == phrase[i];
+        }
+        if (same) {
+            pos += phrase.size();
+            if (pos + 1 < tokens.size() && contains(connectors, tokens[pos].text)) {
+                ++pos;
+            }
+            return pos;
+        }
+    }
+    return pos;
+}
+
+} // namespace
+
+std::string normalizeMerchant(std::string_view description) {
+    std::vector<Token> tokens = tokenize(description);
+
+    size_t begin = skipPrefix(tokens, 0, kTypePrefixes, kTypeConnectors);
+    begin = skipPrefix(tokens, begin, kChannelPrefixes, kChannelConnectors);
+
+    size_t end = tokens.size();
+    while (end > begin && contains(kCompanySuffixes, tokens[end - 1].text)) {
+        --end;
+    }
+
+    std::string merchant;
+    for (size_t i = begin; i < end; ++i) {
+        const Token& token = tokens[i];
+        if (token.hasDigit) {
+            continue;       // Store numbers, transaction ids, dates
+        }
+        if (i + 1 < end && tokens[i + 1].hasDigit && contains(kLocationWords, token.text)) {
+            continue;       // "STORE 001", "LOC 234"
+        }
+        if (!merchant.empty()) {
+            merchant += ' ';
+        }
+        merchant += token.text;
+    }
+    return merchant;
+}
+
+} // namespace BankAnalyzer
@@ -0,0 +1,20 @@
+#pragma once
+#include <string>
+#include <string_view>
+
+namespace BankAnalyzer {
+
+/**
+ * Merchant key for grouping a description's transactions, e.g.
+ * "Purchase Netflix.Com #456" and "NETFLIX.COM STORE 001" both give
+ * "netflixcom".
+ *
+ * Mirrors normalizeMerchantName() in the frontend (fuzzyMatch.ts): drops
+ * leading transaction-type words ("purchase at", "online payment to", ...),
+ * store/location numbers and anything containing a digit, and company
+ * suffixes, then lower-cases what is left. Returns an empty string when
+ * nothing is left.
+ */
+std::string normalizeMerchant(std::string_view description);
+
+} // namespace BankAnalyzer
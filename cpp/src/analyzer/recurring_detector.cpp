@@ -0,0 +1,280 @@
+#include "recurring_detector.h"
+#include "merchant_normalizer.h"
+#include "statement_dates.h"
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+
+namespace BankAnalyzer {
+
+namespace {
+
+enum class Step { Days, Months, Years };
+
+struct Cadence {
+    const char* name;
+    int minGap;             // Accepted gap between occurrences, in days
+    int maxGap;
+    size_t minOccurrences;
+    Step step;              // How the next date is projected
+    int stepCount;
+};
+
+const Cadence kCadences[] = {
+    {"weekly",   6,   8,   4, Step::Days,   7},
+    {"biweekly", 12,  16,  3, Step::Days,   14},
+    {"monthly",  26,  35,  3, Step::Months, 1},
+    {"annual",   350, 380, 3, Step::Years,  1},
+};
+
+struct Occurrence {
+    uint32_t group;         // Merchant and direction
+    uint32_t band;          // Amount band within the group
+    int64_t day;
+    int64_t amount;         // Minor units
+    uint32_t index;         // Position in the input
+};
+
+// A detected band, before joining price changes
+struct Candidate {
+    uint32_t group;
+    const Cadence* cadence;
+    std::vector<uint32_t> members;      // Occurrence indices, oldest first
+    size_t hits;                        // Gaps that kept cadence and amount
+    int64_t firstDay;
+    int64_t lastDay;
+};
+
+bool amountKept(int64_t previous, int64_t next, const RecurringOptions& options) {
+    double allowed = static_cast<double>(previous) * options.amountDrift +
+                     options.amountSlack * static_cast<double>(Money::kMinorPerUnit);
+    return static_cast<double>(next > previous ? next - previous : previous - next) <= allowed;
+}
+
+bool gapFits(const Cadence& cadence, int64_t gap) {
+    return gap >= cadence.minGap && gap <= cadence.maxGap;
+}
+
+int64_t projectNext(const Cadence& cadence, int64_t lastDay) {
+    if (cadence.step == Step::Days) {
+        return lastDay + cadence.stepCount;
+    }
+    StatementDate last = civilFromDays(lastDay);
+    int year = last.year;
+    int month = last.month;
+    if (cadence.step == Step::Months) {
+        month += cadence.stepCount;
+        year += (month - 1) / 12;
+        month = (month - 1) % 12 + 1;
+    } else {
+        year += cadence.stepCount;
+    }
+    return daysFromCivil(year, month, std::min(last.day, daysInMonth(year, month)));
+}
+
+// Series test for one band (occurrences [begin, end), sorted by day)
+bool evaluateBand(const std::vector<Occurrence>& occurrences, size_t begin, size_t end,
+                  const RecurringOptions& options, std::vector<int64_t>& gaps, Candidate& candidate) {
+    size_t count = end - begin;
+    if (count < 2) {
+        return false;
+    }
+
+    gaps.clear();
+    for (size_t i = begin + 1; i < end; ++i) {
+        gaps.push_back(occurrences[i].day - occurrences[i - 1].day);
+    }
+    std::nth_element(gaps.begin(), gaps.begin() + gaps.size() / 2, gaps.end());
+    int64_t median = gaps[gaps.size() / 2];
+
+    const Cadence* cadence = nullptr;
+    for (const Cadence& entry : kCadences) {
+        if (gapFits(entry, median)) {
+            cadence = &entry;
+            break;
+        }
+    }
+    if (!cadence || count < cadence->minOccurrences) {
+        return false;
+    }
+
+    size_t hits = 0;
+    for (size_t i = begin + 1; i < end; ++i) {
+        if (gapFits(*cadence, occurrences[i].day - occurrences[i - 1].day) &&
+            amountKept(occurrences[i - 1].amount, occurrences[i].amount, options)) {
+            ++hits;
+        }
+    }
+    if (static_cast<double>(hits) < options.minConfidence * static_cast<double>(count - 1)) {
+        return false;
+    }
+
+    candidate.group = occurrences[begin].group;
+    candidate.cadence = cadence;
+    candidate.members.clear();
+    for (size_t i = begin; i < end; ++i) {
+        candidate.members.push_back(static_cast<uint32_t>(i));
+    }
+    candidate.hits = hits;
+    candidate.firstDay = occurrences[begin].day;
+    candidate.lastDay = occurrences[end - 1].day;
+    return true;
+}
+
+} // namespace
+
+std::vector<RecurringSeries> detectRecurring(const std::vector<Transaction>& transactions,
+                                             const RecurringOptions& options) {
+    ResolvedDays resolved = resolveTransactionDays(transactions);
+
+    // Group ids per (merchant, direction). Descriptions repeat a lot, so each
+    // distinct one is normalized once.
+    std::unordered_map<std::string_view, uint32_t> descriptionGroups[2];
+    std::unordered_map<std::string, uint32_t> merchantGroups;
+    std::vector<std::string> groupMerchants;
+    const uint32_t kNoGroup = UINT32_MAX;
+
+    std::vector<Occurrence> occurrences;
+    occurrences.reserve(transactions.size());
+    int64_t latestDay = kUnknownDay;
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        const Transaction& txn = transactions[i];
+        int64_t day = resolved.days[i];
+        if (day == kUnknownDay) {
+            continue;
+        }
+        latestDay = std::max(latestDay, day);
+
+        bool credit = txn.type == "credit";
+        auto found = descriptionGroups[credit].find(txn.description);
+        uint32_t group;
+        if (found != descriptionGroups[credit].end()) {
+            group = found->second;
+        } else {
+            std::string merchant = normalizeMerchant(txn.description);
+            group = kNoGroup;
+            if (!merchant.empty()) {
+                std::string key = merchant + (credit ? "\x01" : "\x02");
+                auto inserted = merchantGroups.emplace(std::move(key), static_cast<uint32_t>(groupMerchants.size()));
+                if (inserted.second) {
+                    groupMerchants.push_back(std::move(merchant));
+                }
+                group = inserted.first->second;
+            }
+            descriptionGroups[credit].emplace(txn.description, group);
+        }
+        if (group != kNoGroup) {
+            occurrences.push_back({group, 0, day, txn.amount.minor, static_cast<uint32_t>(i)});
+        }
+    }
+
+    // Amount bands: sorted by amount within each group, a new band starts
+    // wherever consecutive amounts drift too far apart
+    std::sort(occurrences.begin(), occurrences.end(), [](const Occurrence& a, const Occurrence& b) {
+        return a.group != b.group ? a.group < b.group : a.amount < b.amount;
+    });
+    uint32_t band = 0;
+    for (size_t i = 0; i < occurrences.size(); ++i) {
+        if (i > 0 && (occurrences[i].group != occurrences[i - 1].group ||
+                      !amountKept(occurrences[i - 1].amount, occurrences[i].amount, options))) {
+            ++band;
+        }
+        occurrences[i].band = band;
+    }
+
+    // One date sort per band (bands of a group stay adjacent)
+    std::sort(occurrences.begin(), occurrences.end(), [](const Occurrence& a, const Occurrence& b) {
+        if (a.band != b.band) return a.band < b.band;
+        if (a.day != b.day) return a.day < b.day;
+        return a.index < b.index;
+    });
+
+    std::vector<Candidate> candidates;
+    std::vector<int64_t> gaps;
+    Candidate candidate;
+    for (size_t begin = 0; begin < occurrences.size();) {
+        size_t end = begin + 1;
+        while (end < occurrences.size() && occurrences[end].band == occurrences[begin].band) ++end;
+        if (evaluateBand(occurrences, begin, end, options, gaps, candidate)) {
+            candidates.push_back(candidate);
+        }
+        begin = end;
+    }
+
+    // Join bands of one merchant and cadence that pick up where the previous
+    // one stopped (the price changed by more than the drift)
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        if (a.group != b.group) return a.group < b.group;
+        if (a.cadence != b.cadence) return a.cadence < b.cadence;
+        return a.firstDay < b.firstDay;
+    });
+    std::vector<Candidate> joined;
+    for (Candidate& next : candidates) {
+        if (!joined.empty()) {
+            Candidate& previous = joined.back();
+            if (previous.group == next.group && previous.cadence == next.cadence &&
+                gapFits(*next.cadence, next.firstDay - previous.lastDay)) {
+                previous.members.insert(previous.members.end(), next.members.begin(), next.members.end());
+                previous.hits += next.hits + 1;
+                previous.lastDay = next.lastDay;
+                continue;
+            }
+        }
+        joined.push_back(std::move(next));
+    }
+
+    std::vector<RecurringSeries> series;
+    std::vector<int64_t> nextDays;
+    series.reserve(joined.size());
+    for (const Candidate& entry : joined) {
+        const Occurrence& first = occurrences[entry.members.front()];
+        const Occurrence& last = occurrences[entry.members.back()];
+        const Transaction& lastTxn = transactions[last.index];
+
+        RecurringSeries out;
+        out.merchant = groupMerchants[entry.group];
+        out.description = lastTxn.description;
+        out.cadence = entry.cadence->name;
+        out.type = lastTxn.type == "credit" ? "credit" : "debit";
+        out.occurrences = entry.members.size();
+
+        CurrencyCode currency = lastTxn.amount.currency;
+        Money total(0, currency);
+        for (uint32_t member : entry.members) {
+            total += Money(occurrences[member].amount);
+            out.transactions.push_back(occurrences[member].index);
+        }
+        out.averageAmount = total.dividedBy(static_cast<int64_t>(out.occurrences));
+        out.lastAmount = Money(last.amount, currency);
+        out.intervalDays = static_cast<double>(entry.lastDay - entry.firstDay) /
+                           static_cast<double>(out.occurrences - 1);
+        out.confidence = static_cast<double>(entry.hits) / static_cast<double>(out.occurrences - 1);
+        out.firstDate = transactions[first.index].date;
+        out.lastDate = lastTxn.date;
+
+        int64_t nextDay = projectNext(*entry.cadence, entry.lastDay);
+        out.active = latestDay <= nextDay + (entry.cadence->maxGap - entry.cadence->minGap);
+        out.nextDate = formatStatementDate(nextDay, resolved.yearKnown);
+        out.nextAmount = out.lastAmount;
+
+        series.push_back(std::move(out));
+        nextDays.push_back(nextDay);
+    }
+
+    // Active first, then soonest
+    std::vector<size_t> order(series.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        if (series[a].active != series[b].active) return series[a].active;
+        return nextDays[a] < nextDays[b];
+    });
+    std::vector<RecurringSeries> sorted;
+    sorted.reserve(series.size());
+    for (size_t i : order) {
+        sorted.push_back(std::move(series[i]));
+    }
+    return sorted;
+}
+
+} // namespace BankAnalyzer
@@ -0,0 +1,54 @@
+#pragma once
+#include "../extractor/transaction_extractor.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace BankAnalyzer {
+
+/**
+ * Transactions from one merchant at a regular interval: a subscription, a
+ * bill, a paycheque
+ */
+struct RecurringSeries {
+    std::string merchant;           // Normalized merchant (see merchant_normalizer.h)
+    std::string description;        // Latest description as printed
+    std::string cadence;            // "weekly", "biweekly", "monthly" or "annual"
+    std::string type;               // "debit" or "credit"
+    size_t occurrences = 0;
+    Money averageAmount;            // Rounded to the minor unit
+    Money lastAmount;
+    double intervalDays = 0.0;      // Mean gap between occurrences
+    double confidence = 0.0;        // Share of gaps that kept the cadence and amount
+    bool active = false;            // Next occurrence isn't overdue relative to the latest transaction
+    std::string firstDate;          // As printed in the statement
+    std::string lastDate;
+    std::string nextDate;           // Expected next occurrence ("2024-03-15", or "Mar 15" without years)
+    Money nextAmount;
+    std::vector<size_t> transactions;   // Indices into the analyzed vector, oldest first
+};
+
+struct RecurringOptions {
+    double amountDrift = 0.10;      // Allowed change between consecutive charges (fraction)...
+    double amountSlack = 0.50;      // ...plus this much (currency units), so small amounts can move by cents
+    double minConfidence = 0.75;
+};
+
+/**
+ * Find recurring series in a ledger.
+ *
+ * Transactions are grouped by normalized merchant and direction, split into
+ * amount bands (consecutive amounts within the drift), and each band is
+ * sorted by date once, so the whole pass is O(n log n). A band is a series
+ * when its median gap fits a cadence (weekly 6-8 days, biweekly 12-16,
+ * monthly 26-35, annual 350-380), it has enough occurrences (4, 3, 3, 3) and
+ * at least minConfidence of its gaps keep both the cadence and the amount
+ * drift. Bands of one merchant that continue each other (a price change) are
+ * joined into one series.
+ *
+ * Series are returned active first, then by next expected date.
+ */
+std::vector<RecurringSeries> detectRecurring(const std::vector<Transaction>& transactions,
+                                             const RecurringOptions& options = RecurringOptions());
+
+} // namespace BankAnalyzer
@@ -0,0 +1,266 @@
+#include "statement_dates.h"
+#include <cctype>
+#include <cstdio>
+
+namespace BankAnalyzer {
+
+namespace {
+
+struct MonthPrefix {
+    std::string_view prefix;    // Lower case; French accents in both cases
+    int month;
+};
+
+// English and French abbreviations; any trailing letters are skipped
+constexpr MonthPrefix kMonthPrefixes[] = {
+    {"jan", 1}, {"feb", 2}, {"f\xc3\xa9v", 2}, {"f\xc3\x89v", 2}, {"fev", 2},
+    {"mar", 3}, {"apr", 4}, {"avr", 4}, {"may", 5}, {"mai", 5},
+    {"juin", 6}, {"jun", 6}, {"juil", 7}, {"jul", 7},
+    {"aug", 8}, {"ao\xc3\xbb", 8}, {"ao\xc3\x9b", 8}, {"aou", 8},
+    {"sep", 9}, {"oct", 10}, {"nov", 11},
+    {"dec", 12}, {"d\xc3\xa9" "c", 12}, {"d\xc3\x89" "c", 12},
+};
+
+constexpr const char* kMonthAbbreviations[] = {
+    "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec",
+};
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+bool isWordByte(char c) {
+    return std::isalpha(static_cast<unsigned char>(c)) || static_cast<unsigned char>(c) >= 0x80;
+}
+
+size_t skipBlanks(std::string_view text, size_t pos) {
+    while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == ',')) ++pos;
+    return pos;
+}
+
+// Reads up to maxDigits digits; returns how many were read
+size_t readNumber(std::string_view text, size_t pos, size_t maxDigits, int& value) {
+    size_t n = 0;
+    value = 0;
+    while (n < maxDigits && pos + n < text.size() && isDigit(text[pos + n])) {
+        value = value * 10 + (text[pos + n] - '0');
+        ++n;
+    }
+    return n;
+}
+
+// Month name at pos; returns the position after it (and any trailing letters
+// or '.'), or pos if there is none
+size_t readMonthName(std::string_view text, size_t pos, int& month) {
+    for (const MonthPrefix& entry : kMonthPrefixes) {
+        if (pos + entry.prefix.size() > text.size()) {
+            continue;
+        }
+        bool same = true;
+        for (size_t i = 0; i < entry.prefix.size() && same; ++i) {
+            same = std::tolower(static_cast<unsigned char>(text[pos + i])) ==
+                   static_cast<unsigned char>(entry.prefix[i]);
+        }
+        if (same) {
+            month = entry.month;
+            size_t end = pos + entry.prefix.size();
+            while (end < text.size() && isWordByte(text[end])) ++end;
+            if (end < text.size() && text[end] == '.') ++end;
+            return end;
+        }
+    }
+    return pos;
+}
+
+// Optional trailing year after a day ("Jan 5 2024", "05 Jan, 24")
+int readTrailingYear(std::string_view text, size_t pos) {
+    pos = skipBlanks(text, pos);
+    int year = 0;
+    size_t digits = readNumber(text, pos, 4, year);
+    if (digits == 4) return year;
+    if (digits == 2) return 2000 + year;
+    return 0;
+}
+
+StatementDate checked(int year, int month, int day) {
+    StatementDate date;
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year ? year : kUndatedYear, month)) {
+        return date;
+    }
+    date.year = year;
+    date.month = month;
+    date.day = day;
+    return date;
+}
+
+} // namespace
+
+int daysInMonth(int year, int month) {
+    static constexpr int kDays[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return month == 2 && leap ? 29 : kDays[month - 1];
+}
+
+// Howard Hinnant's days_from_civil / civil_from_days
+int64_t daysFromCivil(int year, int month, int day) {
+    int64_t y = year - (month <= 2 ? 1 : 0);
+    int64_t era = (y >= 0 ? y : y - 399) / 400;
+    int64_t yoe = y - era * 400;
+    int64_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+StatementDate civilFromDays(int64_t days) {
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    int64_t doe = days - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+
+    StatementDate date;
+    date.day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+    date.month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+    date.year = static_cast<int>(yoe + era * 400 + (date.month <= 2 ? 1 : 0));
+    return date;
+}
+
+StatementDate parseStatementDate(std::string_view text) {
+    size_t pos = skipBlanks(text, 0);
+    if (pos >= text.size()) {
+        return StatementDate();
+    }
+
+    int first = 0;
+    size_t digits = readNumber(text, pos, 4, first);
+    if (digits == 0) {
+        // "Jan 5", "Janv 1", "Jan 5, 2024"
+        int month = 0;
+        size_t end = readMonthName(text, pos, month);
+        if (end == pos) {
+            return StatementDate();
+        }
+        int day = 0;
+        size_t dayStart = skipBlanks(text, end);
+        size_t dayDigits = readNumber(text, dayStart, 2, day);
+        if (dayDigits == 0) {
+            return StatementDate();
+        }
+        return checked(readTrailingYear(text, dayStart + dayDigits), month, day);
+    }
+
+    pos += digits;
+    if (digits == 4) {
+        // YYYY-MM-DD
+        int month = 0, day = 0;
+        if (pos < text.size() && text[pos] == '-' && readNumber(text, pos + 1, 2, month) == 2 &&
+            pos + 3 < text.size() && text[pos + 3] == '-' && readNumber(text, pos + 4, 2, day) == 2) {
+            return checked(first, month, day);
+        }
+        return StatementDate();
+    }
+    if (digits > 2) {
+        return StatementDate();
+    }
+
+    if (pos < text.size() && (text[pos] == '/' || text[pos] == '-')) {
+        // MM/DD[/YY[YY]]
+        char separator = text[pos];
+        int day = 0;
+        size_t dayDigits = readNumber(text, pos + 1, 2, day);
+        if (dayDigits == 0) {
+            return StatementDate();
+        }
+        pos += 1 + dayDigits;
+        int year = 0;
+        if (pos < text.size() && text[pos] == separator) {
+            size_t yearDigits = readNumber(text, pos + 1, 4, year);
+            if (yearDigits == 2) {
+                year += 2000;
+            } else if (yearDigits != 4) {
+                year = 0;
+            }
+        }
+        if (first > 12 && day <= 12) {
+            return checked(year, day, first);     // DD/MM when it can't be MM/DD
+        }
+        return checked(year, first, day);
+    }
+
+    // "05 Jan", "05 Jan 2024"
+    int month = 0;
+    size_t monthStart = skipBlanks(text, pos);
+    size_t end = readMonthName(text, monthStart, month);
+    if (end == monthStart) {
+        return StatementDate();
+    }
+    return checked(readTrailingYear(text, end), month, first);
+}
+
+namespace {
+
+// Rows in statement order, read through row(i) for i in [0, count)
+template <typename Row>
+ResolvedDays resolveDays(size_t count, Row row) {
+    ResolvedDays resolved;
+    resolved.days.reserve(count);
+
+    int year = kUndatedYear;
+    int previousMonth = 0;
+    for (size_t i = 0; i < count; ++i) {
+        StatementDate date = parseStatementDate(row(i).date);
+        if (!date.valid()) {
+            resolved.days.push_back(kUnknownDay);
+            continue;
+        }
+
+        if (date.year != 0) {
+            year = date.year;
+            resolved.yearKnown = true;
+        } else if (previousMonth != 0) {
+            // Dec -> Jan going forward, Jan -> Dec going backward
+            if (date.month + 6 < previousMonth) {
+                ++year;
+            } else if (date.month > previousMonth + 6) {
+                --year;
+            }
+        }
+        previousMonth = date.month;
+
+        int day = date.day;
+        if (day > daysInMonth(year, date.month)) {
+            day = daysInMonth(year, date.month);     // Feb 29 carried into a non-leap year
+        }
+        resolved.days.push_back(daysFromCivil(year, date.month, day));
+    }
+    return resolved;
+}
+
+} // namespace
+
+ResolvedDays resolveTransactionDays(const std::vector<Transaction>& transactions) {
+    return resolveDays(transactions.size(), [&](size_t i) -> const Transaction& {
+        return transactions[i];
+    });
+}
+
+ResolvedDays resolveTransactionDays(const std::vector<Transaction>& transactions,
+                                    const std::vector<uint32_t>& rows) {
+    return resolveDays(rows.size(), [&](size_t i) -> const Transaction& {
+        return transactions[rows[i]];
+    });
+}
+
+std::string formatStatementDate(int64_t days, bool yearKnown) {
+    StatementDate date = civilFromDays(days);
+    char buffer[16];
+    if (yearKnown) {
+        std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", date.year, date.month, date.day);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%s %02d", kMonthAbbreviations[date.month - 1], date.day);
+    }
+    return buffer;
+}
+
+} // namespace BankAnalyzer
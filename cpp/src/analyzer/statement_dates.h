@@ -0,0 +1,78 @@
+#pragma once
+#include "../extractor/transaction_extractor.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace BankAnalyzer {
+
+/**
+ * A date as printed in a statement's date column.
+ * year is 0 when the statement leaves it out ("Jan 5", "05 Jan", "01/05").
+ */
+struct StatementDate {
+    int year = 0;
+    int month = 0;      // 1-12, 0 if the text isn't a date
+    int day = 0;
+
+    bool valid() const { return month != 0; }
+};
+
+/**
+ * Read the date formats the extraction patterns produce: "Jan 5", "05 Jan",
+ * French month names ("Janv 1", "Févr 3"), MM/DD[/YY[YY]], MM-DD[-YY[YY]]
+ * (DD/MM when the first number can't be a month) and YYYY-MM-DD. Two-digit
+ * years are taken as 20YY.
+ */
+StatementDate parseStatementDate(std::string_view text);
+
+/**
+ * Days since 1970-01-01 (proleptic Gregorian calendar)
+ */
+int64_t daysFromCivil(int year, int month, int day);
+
+/**
+ * Inverse of daysFromCivil()
+ */
+StatementDate civilFromDays(int64_t days);
+
+/**
+ * Number of days in a month
+ */
+int daysInMonth(int year, int month);
+
+/**
+ * Placeholder year for statements that never print one
+ */
+constexpr int kUndatedYear = 2000;
+
+constexpr int64_t kUnknownDay = INT64_MIN;
+
+struct ResolvedDays {
+    std::vector<int64_t> days;      // One per transaction; kUnknownDay if unreadable
+    bool yearKnown = false;         // Some row printed a year
+};
+
+/**
+ * Day numbers (daysFromCivil) for transactions in statement order.
+ * Rows without a year take the year of the nearest dated row before them
+ * (kUndatedYear if there is none), moving to the next year when the month
+ * wraps from late in the year to early (or back, for newest-first
+ * statements), so multi-year exports without years still order correctly.
+ */
+ResolvedDays resolveTransactionDays(const std::vector<Transaction>& transactions);
+
+/**
+ * The same for one statement's rows inside a combined ledger: rows are
+ * indices into transactions, in statement order, and days[i] is rows[i]'s
+ */
+ResolvedDays resolveTransactionDays(const std::vector<Transaction>& transactions,
+                                    const std::vector<uint32_t>& rows);
+
+/**
+ * "2024-03-15", or "Mar 15" when the year is only a placeholder
+ */
+std::string formatStatementDate(int64_t days, bool yearKnown);
+
+} // namespace BankAnalyzer
@@ -0,0 +1,124 @@
+#include "transfer_matcher.h"
+#include "statement_dates.h"
+#include <algorithm>
+#include <numeric>
+#include <string_view>
+#include <unordered_map>
+
+namespace BankAnalyzer {
+
+namespace {
+
+struct AmountKey {
+    int64_t minor;
+    CurrencyCode currency;
+
+    bool operator==(const AmountKey& other) const {
+        return minor == other.minor && currency == other.currency;
+    }
+};
+
+struct AmountKeyHash {
+    size_t operator()(const AmountKey& key) const {
+        return std::hash<int64_t>()(key.minor) ^ (static_cast<size_t>(key.currency) * 0x9E3779B97F4A7C15ull);
+    }
+};
+
+// One side of a candidate transfer
+struct Side {
+    uint32_t bucket;        // Amount and currency
+    uint32_t account;
+    int64_t day;
+    uint32_t index;         // Position in the input
+};
+
+bool byBucketAndDay(const Side& a, const Side& b) {
+    if (a.bucket != b.bucket) return a.bucket < b.bucket;
+    if (a.day != b.day) return a.day < b.day;
+    return a.index < b.index;
+}
+
+// First unpaired credit at or after i; paired ones point past themselves
+uint32_t nextUnpaired(std::vector<uint32_t>& next, uint32_t i) {
+    while (next[i] != i) {
+        next[i] = next[next[i]];
+        i = next[i];
+    }
+    return i;
+}
+
+} // namespace
+
+std::vector<TransferPair> matchTransfers(const std::vector<Transaction>& transactions,
+                                         const TransferOptions& options) {
+    std::vector<TransferPair> pairs;
+
+    // Each account's rows, in order
+    std::unordered_map<std::string_view, uint32_t> accountIds;
+    std::vector<std::vector<uint32_t>> accountRows;
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        const std::string& account = transactions[i].account;
+        if (account.empty()) continue;
+        auto inserted = accountIds.emplace(account, static_cast<uint32_t>(accountRows.size()));
+        if (inserted.second) {
+            accountRows.emplace_back();
+        }
+        accountRows[inserted.first->second].push_back(static_cast<uint32_t>(i));
+    }
+    if (accountRows.size() < 2) {
+        return pairs;
+    }
+
+    // Hash join on amount: rows of one amount and currency share a bucket
+    std::unordered_map<AmountKey, uint32_t, AmountKeyHash> buckets;
+    std::vector<Side> debits;
+    std::vector<Side> credits;
+    for (uint32_t account = 0; account < accountRows.size(); ++account) {
+        const std::vector<uint32_t>& rows = accountRows[account];
+        ResolvedDays resolved = resolveTransactionDays(transactions, rows);
+        for (size_t k = 0; k < rows.size(); ++k) {
+            const Transaction& txn = transactions[rows[k]];
+            bool credit = txn.type == "credit";
+            if ((!credit && txn.type != "debit") || resolved.days[k] == kUnknownDay || txn.amount.minor <= 0) {
+                continue;
+            }
+            AmountKey key{txn.amount.minor, txn.amount.currency};
+            uint32_t bucket = buckets.emplace(key, static_cast<uint32_t>(buckets.size())).first->second;
+            (credit ? credits : debits).push_back({bucket, account, resolved.days[k], rows[k]});
+        }
+    }
+    std::sort(debits.begin(), debits.end(), byBucketAndDay);
+    std::sort(credits.begin(), credits.end(), byBucketAndDay);
+
+    // Date sweep through both lists at once
+    std::vector<uint32_t> next(credits.size() + 1);
+    std::iota(next.begin(), next.end(), 0u);
+    uint32_t first = 0;     // Credits before this are in an earlier bucket or too old for any later debit
+    for (const Side& debit : debits) {
+        while (first < credits.size() &&
+               (credits[first].bucket < debit.bucket ||
+                (credits[first].bucket == debit.bucket && credits[first].day < debit.day - options.windowDays))) {
+            ++first;
+        }
+        for (uint32_t c = nextUnpaired(next, first); c < credits.size(); c = nextUnpaired(next, c + 1)) {
+            const Side& credit = credits[c];
+            if (credit.bucket != debit.bucket || credit.day > debit.day + options.windowDays) {
+                break;
+            }
+            if (credit.account == debit.account) {
+                continue;
+            }
+            int64_t gap = credit.day - debit.day;
+            pairs.push_back({debit.index, credit.index, transactions[debit.index].amount, gap < 0 ? -gap : gap});
+            next[c] = c + 1;
+            break;
+        }
+    }
+
+    std::sort(pairs.begin(), pairs.end(), [](const TransferPair& a, const TransferPair& b) {
+        return a.debit < b.debit;
+    });
+    return pairs;
+}
+
+} // namespace BankAnalyzer
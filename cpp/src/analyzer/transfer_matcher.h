@@ -0,0 +1,45 @@
+#pragma once
+#include "../extractor/transaction_extractor.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace BankAnalyzer {
+
+/**
+ * Both sides of one move of money between the user's own accounts: a card
+ * payment from chequing, "TRANSFER TO SAVINGS". The ledger has it once as a
+ * debit and once as a credit, so neither side is spending or income.
+ */
+struct TransferPair {
+    size_t debit;                   // Index of the outgoing row in the analyzed vector
+    size_t credit;                  // Index of the incoming row
+    Money amount;
+    int64_t dayGap = 0;             // Days between the two sides' dates
+};
+
+struct TransferOptions {
+    int windowDays = 3;             // Largest gap between the sides' dates (posting delay)
+};
+
+/**
+ * Find transfers in a ledger combined from several statements.
+ *
+ * A pair is a debit and a credit of the same amount and currency from
+ * different accounts (Transaction::account; rows without one never pair)
+ * dated at most windowDays apart. Rows are hashed by amount, and each
+ * amount's debits and credits are sorted by date and swept together, so the
+ * pass is O(n log n) rather than a comparison of every pair. In the sweep
+ * each debit, oldest first, takes the oldest unpaired credit from another
+ * account still inside its window; a row is in at most one pair.
+ *
+ * Dates are resolved per account (statement_dates.h), each account's rows
+ * in the order they appear. Pairs are returned in debit order.
+ *
+ * Only teller-cli sets accounts (one per input file); the web app shows one
+ * statement at a time, so its rows never pair.
+ */
+std::vector<TransferPair> matchTransfers(const std::vector<Transaction>& transactions,
+                                         const TransferOptions& options = TransferOptions());
+
+} // namespace BankAnalyzer
@@ -0,0 +1,429 @@
+// teller-bench: extraction and analysis throughput benchmarks.
+// Runs every pattern and the full extract() cascade over the corpus produced by
+// `scripts/generate_test_statements.py --bench-corpus DIR`, then times
+// Analyzer::analyze, the snapshot round trip and table queries at growing
+// ledger sizes.
+// Results are written as JSON so runs can be diffed against each other.
+
+#include "mapped_file.h"
+#include "record_writer.h"
+#include "../extractor/transaction_extractor.h"
+#include "../extractor/pattern_pack.h"
+#include "../analyzer/analyzer.h"
+#include "../snapshot/snapshot.h"
+#include "../query/transaction_index.h"
+#include "../kernels/kernels.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace BankAnalyzer;
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Options {
+    std::string corpus = "bench_corpus";
+    std::string outputPath;          // empty = stdout
+    std::string filter;              // only files whose name contains this
+    double minSeconds = 0.05;        // keep repeating a measurement until this much time has passed
+    int maxPages = 0;                // 0 = no limit
+    bool perPattern = true;
+    bool unbounded = false;          // disable the extractor's step budget and deadline
+    std::string kernels;             // kernel set to use instead of the detected one
+    size_t kernelThreads = 1;
+};
+
+struct CorpusFile {
+    std::string name;                // file stem, e.g. "pattern4_check_100p"
+    std::string layout;              // e.g. "pattern4_check"
+    int pages;
+    std::string path;
+};
+
+struct Measurement {
+    double seconds = 0.0;            // mean wall time per iteration
+    size_t iterations = 0;
+    uint64_t allocations = 0;        // per iteration (0 when built with TELLER_METRICS off)
+    size_t transactions = 0;
+};
+
+// Repeat fn until minSeconds has elapsed; fn returns the transaction count
+template <typename Fn>
+Measurement measure(Fn fn, double minSeconds) {
+    Measurement m;
+    double total = 0.0;
+    do {
+        uint64_t allocationsBefore = threadAllocationCount();
+        auto start = std::chrono::steady_clock::now();
+        m.transactions = fn();
+        total += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        m.allocations = threadAllocationCount() - allocationsBefore;
+        ++m.iterations;
+    } while (total < minSeconds);
+    m.seconds = total / m.iterations;
+    return m;
+}
+
+void appendNumber(std::string& out, const char* key, double value) {
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "\"%s\":%.6g", key, value);
+    out += buffer;
+}
+
+void appendMeasurement(std::string& out, const Measurement& m, size_t bytes) {
+    appendNumber(out, "seconds", m.seconds);
+    out += ",";
+    appendNumber(out, "iterations", static_cast<double>(m.iterations));
+    out += ",";
+    appendNumber(out, "transactions", static_cast<double>(m.transactions));
+    out += ",";
+    if (bytes > 0) {
+        appendNumber(out, "mbPerSecond", m.seconds > 0 ? bytes / m.seconds / 1e6 : 0.0);
+        out += ",";
+    }
+    appendNumber(out, "transactionsPerSecond", m.seconds > 0 ? m.transactions / m.seconds : 0.0);
+    out += ",";
+    appendNumber(out, "allocations", static_cast<double>(m.allocations));
+    out += ",";
+    appendNumber(out, "allocationsPerTransaction",
+                 m.transactions > 0 ? static_cast<double>(m.allocations) / m.transactions : 0.0);
+}
+
+// Where the pattern's matches went (from the extractor's metrics layer)
+void appendFilterCounts(std::string& out, const PatternStats& stats) {
+    out += ",";
+    appendNumber(out, "attempted", static_cast<double>(stats.attempted));
+    out += ",";
+    appendNumber(out, "accepted", static_cast<double>(stats.accepted));
+    out += ",";
+    appendNumber(out, "steps", static_cast<double>(stats.steps));
+    out += ",\"aborted\":";
+    out += stats.aborted ? "true" : "false";
+    out += ",\"rejected\":{";
+    appendNumber(out, "header", static_cast<double>(stats.rejectedHeader));
+    out += ",";
+    appendNumber(out, "tooShort", static_cast<double>(stats.rejectedTooShort));
+    out += ",";
+    appendNumber(out, "noDate", static_cast<double>(stats.rejectedNoDate));
+    out += ",";
+    appendNumber(out, "noAmount", static_cast<double>(stats.rejectedNoAmount));
+    out += "}";
+}
+
+void printUsage(const char* program) {
+    std::fprintf(stderr,
+        "Usage: %s [options]\n"
+        "\n"
+        "Options:\n"
+        "  --corpus DIR        Corpus directory (default: bench_corpus)\n"
+        "                      Generate it with: scripts/generate_test_statements.py --bench-corpus DIR\n"
+        "  -o, --output FILE   Write JSON results to FILE instead of stdout\n"
+        "  --filter TEXT       Only benchmark corpus files whose name contains TEXT\n"
+        "  --max-pages N       Skip corpus files with more than N pages\n"
+        "  --min-time SECONDS  Minimum time per measurement (default: 0.05)\n"
+        "  --cascade-only      Skip the per-pattern runs\n"
+        "  --unbounded         Disable the step budget and deadline (raw regex cost)\n"
+        "  --kernels NAME      Kernel set to use (scalar, sse2, avx2; default: widest available)\n"
+        "  --kernel-threads N  Threads the kernels may use (default: 1)\n",
+        program);
+}
+
+bool parseArgs(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            std::exit(0);
+        } else if (arg == "--corpus" && hasValue) {
+            options.corpus = argv[++i];
+        } else if ((arg == "-o" || arg == "--output") && hasValue) {
+            options.outputPath = argv[++i];
+        } else if (arg == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        } else if (arg == "--max-pages" && hasValue) {
+            options.maxPages = std::atoi(argv[++i]);
+        } else if (arg == "--min-time" && hasValue) {
+            options.minSeconds = std::atof(argv[++i]);
+        } else if (arg == "--cascade-only") {
+            options.perPattern = false;
+        } else if (arg == "--unbounded") {
+            options.unbounded = true;
+        } else if (arg == "--kernels" && hasValue) {
+            options.kernels = argv[++i];
+        } else if (arg == "--kernel-threads" && hasValue) {
+            options.kernelThreads = static_cast<size_t>(std::atoi(argv[++i]));
+        } else {
+            std::fprintf(stderr, "teller-bench: bad argument '%s'\n", arg.c_str());
+            printUsage(argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Corpus files are named <layout>_<pages>p.txt
+bool parseCorpusName(const fs::path& path, CorpusFile& file) {
+    if (path.extension() != ".txt") {
+        return false;
+    }
+    std::string stem = path.stem().string();
+    size_t underscore = stem.rfind('_');
+    if (underscore == std::string::npos || stem.back() != 'p') {
+        return false;
+    }
+
+    file.name = stem;
+    file.layout = stem.substr(0, underscore);
+    file.pages = std::atoi(stem.c_str() + underscore + 1);
+    file.path = path.string();
+    return file.pages > 0;
+}
+
+// Ledger for the analyzer runs: the corpus transactions repeated up to count
+std::vector<Transaction> buildLedger(const std::vector<Transaction>& seed, size_t count) {
+    std::vector<Transaction> ledger;
+    ledger.reserve(count);
+    while (ledger.size() < count && !seed.empty()) {
+        ledger.push_back(seed[ledger.size() % seed.size()]);
+    }
+    return ledger;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseArgs(argc, argv, options)) {
+        return 2;
+    }
+
+    std::vector<CorpusFile> corpus;
+    std::error_code ec;
+    for (fs::directory_iterator it(options.corpus, ec), end; it != end; it.increment(ec)) {
+        CorpusFile file;
+        if (!parseCorpusName(it->path(), file)) continue;
+        if (options.maxPages > 0 && file.pages > options.maxPages) continue;
+        if (!options.filter.empty() && file.name.find(options.filter) == std::string::npos) continue;
+        corpus.push_back(file);
+    }
+    if (corpus.empty()) {
+        std::fprintf(stderr, "teller-bench: no corpus files in '%s'\n"
+                             "Generate them with: python3 scripts/generate_test_statements.py --bench-corpus %s\n",
+                     options.corpus.c_str(), options.corpus.c_str());
+        return 1;
+    }
+    std::sort(corpus.begin(), corpus.end(), [](const CorpusFile& a, const CorpusFile& b) {
+        return a.layout != b.layout ? a.layout < b.layout : a.pages < b.pages;
+    });
+
+    if (!options.kernels.empty() && !selectKernelSet(options.kernels)) {
+        std::fprintf(stderr, "teller-bench: kernel set '%s' isn't available here\n", options.kernels.c_str());
+        return 2;
+    }
+    setKernelThreads(options.kernelThreads);
+
+    TransactionExtractor extractor;
+    extractor.addPatternPack(extendedPatternPack());
+    if (options.unbounded) {
+        ExtractionLimits limits;
+        limits.baseSteps = UINT64_MAX / 2;
+        limits.stepsPerByte = 0;
+        limits.deadlineMs = 0;
+        extractor.setLimits(limits);
+    }
+    std::vector<Transaction> analyzerSeed;
+    std::string json = "{\"benchmark\":\"teller-bench\",\"schema\":1,";
+    appendNumber(json, "minSeconds", options.minSeconds);
+    json += ",\"unbounded\":";
+    json += options.unbounded ? "true" : "false";
+    json += ",\"kernels\":";
+    appendJsonString(json, kernels().name);
+    json += ",";
+    appendNumber(json, "kernelThreads", static_cast<double>(kernelThreads()));
+    json += ",\"files\":[";
+
+    for (size_t f = 0; f < corpus.size(); ++f) {
+        const CorpusFile& file = corpus[f];
+        MappedFile mapped;
+        std::string error;
+        if (!mapped.open(file.path, error)) {
+            std::fprintf(stderr, "teller-bench: %s\n", error.c_str());
+            return 1;
+        }
+        std::string_view text = mapped.view();
+        std::fprintf(stderr, "[%zu/%zu] %s (%zu bytes)\n", f + 1, corpus.size(), file.name.c_str(), text.size());
+
+        if (f > 0) json += ",";
+        json += "{\"name\":";
+        appendJsonString(json, file.name);
+        json += ",\"layout\":";
+        appendJsonString(json, file.layout);
+        json += ",";
+        appendNumber(json, "pages", file.pages);
+        json += ",";
+        appendNumber(json, "bytes", static_cast<double>(text.size()));
+
+        if (options.perPattern) {
+            json += ",\"patterns\":[";
+            bool first = true;
+            for (int pattern : extractor.patternCascade()) {
+                Measurement m = measure([&] {
+                    return extractor.extractWithPattern(pattern, text).size();
+                }, options.minSeconds);
+
+                if (!first) json += ",";
+                first = false;
+                json += "{";
+                appendNumber(json, "pattern", pattern);
+                json += ",\"name\":";
+                appendJsonString(json, TransactionExtractor::patternName(pattern));
+                json += ",";
+                appendMeasurement(json, m, text.size());
+                appendFilterCounts(json, extractor.stats().pattern(pattern));
+                json += "}";
+            }
+            json += "]";
+        }
+
+        std::vector<Transaction> extracted;
+        Measurement cascade = measure([&] {
+            extracted = extractor.extract(text);
+            return extracted.size();
+        }, options.minSeconds);
+        json += ",\"cascade\":{";
+        appendNumber(json, "matchedPattern", extractor.stats().matchedPattern);
+        json += ",";
+        appendNumber(json, "records", extractor.stats().records);
+        json += ",\"deadlineExceeded\":";
+        json += extractor.stats().deadlineExceeded ? "true," : "false,";
+        appendMeasurement(json, cascade, text.size());
+        json += "}}";
+
+        if (extracted.size() > analyzerSeed.size()) {
+            analyzerSeed = std::move(extracted);
+        }
+    }
+    json += "]";
+
+    // Analyzer scaling over synthetic ledgers built from the richest extraction
+    json += ",\"analyzer\":[";
+    Analyzer analyzer;
+    bool first = true;
+    for (size_t count : {1000, 10000, 100000, 1000000}) {
+        if (analyzerSeed.empty()) break;
+        std::vector<Transaction> ledger = buildLedger(analyzerSeed, count);
+        std::fprintf(stderr, "analyzer: %zu transactions\n", count);
+
+        Measurement m = measure([&] {
+            AnalysisResult result = analyzer.analyze(ledger);
+            return ledger.size();
+        }, options.minSeconds);
+
+        if (!first) json += ",";
+        first = false;
+        json += "{";
+        appendMeasurement(json, m, 0);
+        json += "}";
+    }
+    json += "]";
+
+    // Snapshot round trip: build from a ledger, then reopen it (the cache-hit path)
+    json += ",\"snapshot\":[";
+    first = true;
+    for (size_t count : {1000, 10000, 100000, 1000000}) {
+        if (analyzerSeed.empty()) break;
+        std::vector<Transaction> ledger = buildLedger(analyzerSeed, count);
+        AnalysisResult analysis = analyzer.analyze(ledger);
+        std::fprintf(stderr, "snapshot: %zu transactions\n", count);
+
+        std::string snapshot;
+        Measurement build = measure([&] {
+            snapshot = buildSnapshot(ledger, analysis, 0);
+            return ledger.size();
+        }, options.minSeconds);
+        Measurement reopen = measure([&] {
+            SnapshotView view;
+            std::string error;
+            if (!view.open(snapshot, error)) return static_cast<size_t>(0);
+            return view.transactions().size();
+        }, options.minSeconds);
+
+        if (!first) json += ",";
+        first = false;
+        json += "{";
+        appendNumber(json, "bytes", static_cast<double>(snapshot.size()));
+        json += ",\"build\":{";
+        appendMeasurement(json, build, 0);
+        json += "},\"open\":{";
+        appendMeasurement(json, reopen, 0);
+        json += "}}";
+    }
+    json += "]";
+
+    // Transaction table queries: index build, a description search, and a
+    // sorted page once the permutation exists
+    json += ",\"query\":[";
+    first = true;
+    for (size_t count : {10000, 100000, 1000000}) {
+        if (analyzerSeed.empty()) break;
+        std::vector<Transaction> ledger = buildLedger(analyzerSeed, count);
+        std::fprintf(stderr, "query: %zu transactions\n", count);
+
+        TransactionIndex index;
+        Measurement build = measure([&] {
+            index.build(ledger);
+            return ledger.size();
+        }, options.minSeconds);
+
+        TransactionQuery search;
+        search.text = ledger[0].description.substr(0, 4);
+        search.descending = true;
+        Measurement searched = measure([&] {
+            return index.query(search).total;
+        }, options.minSeconds);
+
+        TransactionQuery sorted;
+        sorted.sort = SortKey::Amount;
+        sorted.descending = true;
+        index.query(sorted);
+        Measurement paged = measure([&] {
+            return index.query(sorted).rows.size();
+        }, options.minSeconds);
+
+        if (!first) json += ",";
+        first = false;
+        json += "{";
+        appendNumber(json, "transactions", static_cast<double>(count));
+        json += ",\"build\":{";
+        appendMeasurement(json, build, 0);
+        json += "},\"search\":{";
+        appendMeasurement(json, searched, 0);
+        json += "},\"sortedPage\":{";
+        appendMeasurement(json, paged, 0);
+        json += "}}";
+    }
+    json += "]}\n";
+
+    FILE* output = stdout;
+    if (!options.outputPath.empty()) {
+        output = std::fopen(options.outputPath.c_str(), "wb");
+        if (!output) {
+            std::fprintf(stderr, "teller-bench: cannot open %s\n", options.outputPath.c_str());
+            return 1;
+        }
+    }
+    std::fwrite(json.data(), 1, json.size(), output);
+    if (output != stdout) {
+        std::fclose(output);
+    }
+    return 0;
+}
@@ -0,0 +1,163 @@
+#pragma once
+#include <emscripten/val.h>
+#include "../extractor/transaction_extractor.h"
+#include "../extractor/extraction_job.h"
+#include "../extractor/scratch_arena.h"
+#include "../kernels/kernels.h"
+#include <memory>
+
+// Conversions shared by the base module (main.cpp) and the extended pattern
+// pack module (pattern_pack.cpp)
+
+namespace BankAnalyzer {
+
+inline emscripten::val transactionsToJS(const std::vector<Transaction>& transactions) {
+    using emscripten::val;
+
+    // Convert to JavaScript array
+    val jsTransactions = val::array();
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        val jsTxn = val::object();
+        jsTxn.set("date", transactions[i].date);
+        jsTxn.set("description", transactions[i].description);
+        jsTxn.set("amount", transactions[i].amount.toUnits());
+        jsTxn.set("balance", transactions[i].balance.toUnits());
+        jsTxn.set("type", transactions[i].type);
+        jsTxn.set("category", transactions[i].category);
+        jsTxn.set("currency", currencyName(transactions[i].amount.currency));
+        jsTxn.set("balanceMismatch", transactions[i].balanceMismatch);
+        jsTransactions.set(i, jsTxn);
+    }
+
+    return jsTransactions;
+}
+
+// Metrics for one extraction; cascade is the pattern order it ran in
+inline emscripten::val extractorStatsToJS(const ExtractorStats& stats, const std::vector<int>& cascade) {
+    using emscripten::val;
+
+    val jsStats = val::object();
+    jsStats.set("metricsEnabled", TELLER_METRICS != 0);
+    jsStats.set("matchedPattern", stats.matchedPattern);
+    jsStats.set("deadlineExceeded", stats.deadlineExceeded);
+    jsStats.set("milliseconds", stats.nanoseconds / 1e6);
+    jsStats.set("bytesScanned", static_cast<double>(stats.bytesScanned));
+    jsStats.set("records", static_cast<double>(stats.records));
+    jsStats.set("allocations", static_cast<double>(stats.allocations));
+    jsStats.set("scratchBytes", static_cast<double>(stats.scratchBytes));
+    jsStats.set("scratchOverflows", static_cast<double>(stats.scratchOverflows));
+
+    // Only the patterns the cascade actually ran
+    val jsPatterns = val::array();
+    val jsAborted = val::array();
+    unsigned int index = 0;
+    unsigned int abortedCount = 0;
+    for (int id : cascade) {
+        const PatternStats& pattern = stats.pattern(id);
+        if (pattern.steps == 0 && !pattern.aborted && id != stats.matchedPattern) {
+            continue;
+        }
+        if (pattern.aborted) {
+            jsAborted.set(abortedCount++, id);
+        }
+
+        val jsRejected = val::object();
+        jsRejected.set("header", static_cast<double>(pattern.rejectedHeader));
+        jsRejected.set("tooShort", static_cast<double>(pattern.rejectedTooShort));
+        jsRejected.set("noDate", static_cast<double>(pattern.rejectedNoDate));
+        jsRejected.set("noAmount", static_cast<double>(pattern.rejectedNoAmount));
+
+        val jsPattern = val::object();
+        jsPattern.set("pattern", id);
+        jsPattern.set("name", std::string(TransactionExtractor::patternName(id)));
+        jsPattern.set("milliseconds", pattern.nanoseconds / 1e6);
+        jsPattern.set("bytesScanned", static_cast<double>(pattern.bytesScanned));
+        jsPattern.set("allocations", static_cast<double>(pattern.allocations));
+        jsPattern.set("attempted", static_cast<double>(pattern.attempted));
+        jsPattern.set("accepted", static_cast<double>(pattern.accepted));
+        jsPattern.set("rejected", jsRejected);
+        jsPattern.set("steps", static_cast<double>(pattern.steps));
+        jsPattern.set("aborted", pattern.aborted);
+        jsPatterns.set(index++, jsPattern);
+    }
+    jsStats.set("patterns", jsPatterns);
+
+    val jsBalance = val::object();
+    jsBalance.set("rows", static_cast<double>(stats.balance.rows));
+    jsBalance.set("inferred", static_cast<double>(stats.balance.inferred));
+    jsBalance.set("corrected", static_cast<double>(stats.balance.corrected));
+    jsBalance.set("mismatches", static_cast<double>(stats.balance.mismatches));
+    jsBalance.set("keywordFallbacks", static_cast<double>(stats.balance.keywordFallbacks));
+    jsBalance.set("newestFirst", stats.balance.newestFirst);
+    jsStats.set("balance", jsBalance);
+    jsStats.set("aborted", jsAborted);   // Patterns abandoned for exceeding their budget
+
+    return jsStats;
+}
+
+// The module's time-sliced extraction (startExtraction/continueExtraction);
+// it also answers getExtractorStats() until the next extractTransactions()
+inline std::unique_ptr<ExtractionJob>& activeExtraction() {
+    static std::unique_ptr<ExtractionJob> job;
+    return job;
+}
+
+// Metrics for the module's most recent extraction, whole or time-sliced
+inline emscripten::val extractorStatsToJS(const TransactionExtractor& extractor) {
+    const ExtractionJob* job = activeExtraction().get();
+    return extractorStatsToJS(job ? job->stats() : extractor.stats(), extractor.patternCascade());
+}
+
+// Run the active job for up to maxBytes of text / maxMilliseconds (0 = no
+// limit on that). Returns its progress; the last one (done) carries the
+// transactions.
+inline emscripten::val continueActiveExtraction(double maxBytes, double maxMilliseconds) {
+    using emscripten::val;
+    ExtractionJob* job = activeExtraction().get();
+    ExtractionProgress progress;
+    if (job) {
+        progress = job->step(static_cast<size_t>(maxBytes), maxMilliseconds);
+    } else {
+        progress.done = true;
+        progress.cancelled = true;
+    }
+
+    val jsProgress = val::object();
+    jsProgress.set("bytesProcessed", static_cast<double>(progress.bytesProcessed));
+    jsProgress.set("totalBytes", static_cast<double>(progress.totalBytes));
+    jsProgress.set("found", static_cast<double>(progress.transactions));
+    jsProgress.set("pattern", progress.pattern);
+    jsProgress.set("patternName", std::string(progress.pattern ? TransactionExtractor::patternName(progress.pattern) : ""));
+    jsProgress.set("patternsTried", static_cast<double>(progress.patternsTried));
+    jsProgress.set("patternCount", static_cast<double>(progress.patternCount));
+    jsProgress.set("done", progress.done);
+    jsProgress.set("cancelled", progress.cancelled);
+    if (job && progress.done && !progress.cancelled) {
+        jsProgress.set("transactions", transactionsToJS(job->takeTransactions()));
+    }
+    return jsProgress;
+}
+
+// Tune the per-pattern work budget and whole-document deadline (see match_budget.h)
+inline void applyExtractionLimits(TransactionExtractor& extractor, double stepsPerByte, double deadlineMs) {
+    ExtractionLimits limits = extractor.limits();
+    limits.stepsPerByte = static_cast<uint64_t>(stepsPerByte);
+    limits.deadlineMs = deadlineMs;
+    extractor.setLimits(limits);
+}
+
+// Cap the scratch arena that backs extraction/analysis (see scratch_arena.h)
+inline void applyScratchCapacity(double megabytes) {
+    ScratchArena::forThisThread().setCapacity(static_cast<size_t>(megabytes * 1024 * 1024));
+}
+
+// Which kernel set this module runs and how many threads it may use
+// (see kernels.h); the set follows from the module variant
+inline emscripten::val kernelInfoToJS() {
+    emscripten::val info = emscripten::val::object();
+    info.set("kernels", std::string(kernels().name));
+    info.set("threads", static_cast<double>(kernelThreads()));
+    return info;
+}
+
+} // namespace BankAnalyzer
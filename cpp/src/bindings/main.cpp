@@ -1,71 +1,269 @@
 #include <emscripten/bind.h>
 #include <emscripten/val.h>
 #include "../extractor/transaction_extractor.h"
+#include "extractor_bindings.h"
 #include "../analyzer/analyzer.h"
+#include "../snapshot/snapshot.h"
+#include "../query/transaction_index.h"
+#include <cstdlib>
 
 using namespace emscripten;
 using namespace BankAnalyzer;
 
+// Base module: Patterns 2, 1 and 3 (no std::regex). When they find nothing
+// the frontend loads the extended pattern pack module (pattern_pack.cpp).
+
+// One extractor for the module so getExtractorStats() can report on the last call
+TransactionExtractor& sharedExtractor() {
+    static TransactionExtractor extractor;
+    return extractor;
+}
+
 // Wrapper function to extract transactions
 val extractTransactions(const std::string& text) {
-    TransactionExtractor extractor;
-    std::vector<Transaction> transactions = extractor.extract(text);
-
-    // Convert to JavaScript array
-    val jsTransactions = val::array();
-    for (size_t i = 0; i < transactions.size(); ++i) {
-        val jsTxn = val::object();
-        jsTxn.set("date", transactions[i].date);
-        jsTxn.set("description", transactions[i].description);
-        jsTxn.set("amount", transactions[i].amount);
-        jsTxn.set("balance", transactions[i].balance);
-        jsTxn.set("type", transactions[i].type);
-        jsTxn.set("category", transactions[i].category);
-        jsTransactions.set(i, jsTxn);
-    }
+    activeExtraction().reset();
+    return transactionsToJS(sharedExtractor().extract(text));
+}
 
-    return jsTransactions;
+// Time-sliced extraction for the UI thread: start, then continue until the
+// progress says done (see extraction_job.h). Starting again drops the old job.
+void startExtraction(const std::string& text) {
+    activeExtraction() = std::make_unique<ExtractionJob>(sharedExtractor(), text);
 }
 
-// Wrapper function for analysis
-val analyzeTransactions(const val& jsTransactions) {
-    // Convert JavaScript array to C++ vector
+val continueExtraction(double maxBytes, double maxMilliseconds) {
+    return continueActiveExtraction(maxBytes, maxMilliseconds);
+}
+
+// Stop the job and free its text and partial results
+void cancelExtraction() {
+    if (activeExtraction()) {
+        activeExtraction()->cancel();
+    }
+}
+
+// Convert a JavaScript transaction array to a C++ vector
+std::vector<Transaction> transactionsFromJS(const val& jsTransactions) {
     std::vector<Transaction> transactions;
     unsigned int length = jsTransactions["length"].as<unsigned int>();
+    transactions.reserve(length);
 
     for (unsigned int i = 0; i < length; ++i) {
         val jsTxn = jsTransactions[i];
         Transaction txn;
         txn.date = jsTxn["date"].as<std::string>();
         txn.description = jsTxn["description"].as<std::string>();
-        txn.amount = jsTxn["amount"].as<double>();
-        txn.balance = jsTxn["balance"].as<double>();
+        // JS numbers back to exact minor units; rows saved before the
+        // currency field existed have none
+        val jsCurrency = jsTxn["currency"];
+        CurrencyCode currency = jsCurrency.isString() ? currencyFromCode(jsCurrency.as<std::string>()) : kNoCurrency;
+        txn.amount = Money::fromUnits(jsTxn["amount"].as<double>(), currency);
+        txn.balance = Money::fromUnits(jsTxn["balance"].as<double>(), currency);
         txn.type = jsTxn["type"].as<std::string>();
         txn.category = jsTxn["category"].as<std::string>();
+        txn.balanceMismatch = jsTxn["balanceMismatch"].isTrue();
         transactions.push_back(txn);
     }
+    return transactions;
+}
 
-    Analyzer analyzer;
-    AnalysisResult result = analyzer.analyze(transactions);
-
-    // Convert result to JavaScript object
+val analysisToJS(const AnalysisResult& result) {
     val jsResult = val::object();
-    jsResult.set("totalIncome", result.totalIncome);
-    jsResult.set("totalExpenses", result.totalExpenses);
-    jsResult.set("netChange", result.netChange);
+    jsResult.set("totalIncome", result.totalIncome.toUnits());
+    jsResult.set("totalExpenses", result.totalExpenses.toUnits());
+    jsResult.set("netChange", result.netChange.toUnits());
+    jsResult.set("currency", currencyName(result.netChange.currency));
 
     // Convert category totals
     val jsCategoryTotals = val::object();
     for (const auto& pair : result.categoryTotals) {
-        jsCategoryTotals.set(pair.first, pair.second);
+        jsCategoryTotals.set(pair.first, pair.second.toUnits());
     }
     jsResult.set("categoryTotals", jsCategoryTotals);
 
+    // Recurring series, active first
+    val jsRecurring = val::array();
+    for (size_t i = 0; i < result.recurring.size(); ++i) {
+        const RecurringSeries& series = result.recurring[i];
+        val jsSeries = val::object();
+        jsSeries.set("merchant", series.merchant);
+        jsSeries.set("description", series.description);
+        jsSeries.set("cadence", series.cadence);
+        jsSeries.set("type", series.type);
+        jsSeries.set("occurrences", static_cast<double>(series.occurrences));
+        jsSeries.set("averageAmount", series.averageAmount.toUnits());
+        jsSeries.set("lastAmount", series.lastAmount.toUnits());
+        jsSeries.set("intervalDays", series.intervalDays);
+        jsSeries.set("confidence", series.confidence);
+        jsSeries.set("active", series.active);
+        jsSeries.set("firstDate", series.firstDate);
+        jsSeries.set("lastDate", series.lastDate);
+        jsSeries.set("nextDate", series.nextDate);
+        jsSeries.set("nextAmount", series.nextAmount.toUnits());
+
+        val jsIndices = val::array();
+        for (size_t j = 0; j < series.transactions.size(); ++j) {
+            jsIndices.set(j, static_cast<double>(series.transactions[j]));
+        }
+        jsSeries.set("transactions", jsIndices);
+        jsRecurring.set(i, jsSeries);
+    }
+    jsResult.set("recurring", jsRecurring);
+
     return jsResult;
 }
 
+// Wrapper function for analysis
+val analyzeTransactions(const val& jsTransactions) {
+    Analyzer analyzer;
+    return analysisToJS(analyzer.analyze(transactionsFromJS(jsTransactions)));
+}
+
+// Cache key for a statement's text (16 hex digits)
+std::string hashStatement(const std::string& text) {
+    return formatSnapshotKey(hashStatementText(text));
+}
+
+// Snapshot of categorized transactions and their analysis, as a Uint8Array
+// for IndexedDB
+val encodeSnapshot(const val& jsTransactions, const std::string& key) {
+    std::vector<Transaction> transactions = transactionsFromJS(jsTransactions);
+    Analyzer analyzer;
+    AnalysisResult analysis = analyzer.analyze(transactions);
+    std::string snapshot = buildSnapshot(transactions, analysis, std::strtoull(key.c_str(), nullptr, 16));
+
+    // typed_memory_view points into the WASM heap; new Uint8Array() copies it out
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(snapshot.data());
+    return val::global("Uint8Array").new_(typed_memory_view(snapshot.size(), data));
+}
+
+// { key, transactions, analysis } from a stored snapshot, or null if it is
+// corrupt or from another snapshot version
+val decodeSnapshot(const val& jsBytes) {
+    std::string bytes(jsBytes["length"].as<size_t>(), '\0');
+    unsigned char* data = reinterpret_cast<unsigned char*>(&bytes[0]);
+    val(typed_memory_view(bytes.size(), data)).call<void>("set", jsBytes);
+
+    SnapshotView snapshot;
+    std::string error;
+    if (!snapshot.open(bytes, error)) {
+        return val::null();
+    }
+
+    val jsSnapshot = val::object();
+    jsSnapshot.set("key", formatSnapshotKey(snapshot.sourceHash()));
+    jsSnapshot.set("transactions", transactionsToJS(snapshot.transactions()));
+    jsSnapshot.set("analysis", analysisToJS(snapshot.analysis()));
+    return jsSnapshot;
+}
+
+// Ledger the transaction table queries run against
+struct QueryState {
+    std::vector<Transaction> ledger;
+    TransactionIndex index;
+};
+
+QueryState& queryState() {
+    static QueryState state;
+    return state;
+}
+
+// Replace the queried ledger (call whenever the table's transactions change)
+void loadQueryLedger(const val& jsTransactions) {
+    QueryState& state = queryState();
+    state.ledger = transactionsFromJS(jsTransactions);
+    state.index.build(state.ledger);
+}
+
+SortKey sortKeyFromName(const std::string& name) {
+    if (name == "description") return SortKey::Description;
+    if (name == "category") return SortKey::Category;
+    if (name == "merchant") return SortKey::Merchant;
+    if (name == "type") return SortKey::Type;
+    if (name == "amount") return SortKey::Amount;
+    if (name == "balance") return SortKey::Balance;
+    return SortKey::Date;
+}
+
+// { total, rows } for { text, type, categories, sort, descending, offset, limit };
+// rows is a Uint32Array of indices into the loaded ledger
+val queryTransactions(const val& jsQuery) {
+    TransactionQuery request;
+    auto has = [&](const char* field) {
+        return !jsQuery[field].isUndefined() && !jsQuery[field].isNull();
+    };
+    if (has("text")) request.text = jsQuery["text"].as<std::string>();
+    if (has("type")) request.type = jsQuery["type"].as<std::string>();
+    if (has("categories")) {
+        val jsCategories = jsQuery["categories"];
+        unsigned int length = jsCategories["length"].as<unsigned int>();
+        for (unsigned int i = 0; i < length; ++i) {
+            request.categories.push_back(jsCategories[i].as<std::string>());
+        }
+    }
+    if (has("sort")) request.sort = sortKeyFromName(jsQuery["sort"].as<std::string>());
+    if (has("descending")) request.descending = jsQuery["descending"].as<bool>();
+    if (has("offset")) request.offset = static_cast<size_t>(jsQuery["offset"].as<double>());
+    if (has("limit")) request.limit = static_cast<size_t>(jsQuery["limit"].as<double>());
+
+    QueryResult result = queryState().index.query(request);
+
+    val jsResult = val::object();
+    jsResult.set("total", static_cast<double>(result.total));
+    jsResult.set("rows", val::global("Uint32Array").new_(typed_memory_view(result.rows.size(), result.rows.data())));
+    return jsResult;
+}
+
+// Keep the index in step with a category correction in the table
+void setQueryCategory(double row, const std::string& category) {
+    QueryState& state = queryState();
+    size_t index = static_cast<size_t>(row);
+    if (index < state.ledger.size()) {
+        state.ledger[index].category = category;
+        state.index.setCategory(index, category);
+    }
+}
+
+// Metrics for the most recent extractTransactions() call or extraction job
+val getExtractorStats() {
+    return extractorStatsToJS(sharedExtractor());
+}
+
+void setExtractionLimits(double stepsPerByte, double deadlineMs) {
+    applyExtractionLimits(sharedExtractor(), stepsPerByte, deadlineMs);
+}
+
+// Cap the memory kept between calls for extraction/analysis scratch
+void setScratchCapacity(double megabytes) {
+    applyScratchCapacity(megabytes);
+}
+
+val getKernelInfo() {
+    return kernelInfoToJS();
+}
+
+// Threads the kernels may use; only the simd-threads module has any, and it
+// holds the count to its pre-started workers
+void setThreadCount(double threads) {
+    setKernelThreads(static_cast<size_t>(threads));
+}
+
 // Bind functions to JavaScript
 EMSCRIPTEN_BINDINGS(bank_analyzer) {
     function("extractTransactions", &extractTransactions);
+    function("startExtraction", &startExtraction);
+    function("continueExtraction", &continueExtraction);
+    function("cancelExtraction", &cancelExtraction);
     function("analyzeTransactions", &analyzeTransactions);
+    function("getExtractorStats", &getExtractorStats);
+    function("setExtractionLimits", &setExtractionLimits);
+    function("setScratchCapacity", &setScratchCapacity);
+    function("getKernelInfo", &getKernelInfo);
+    function("setThreadCount", &setThreadCount);
+    function("hashStatement", &hashStatement);
+    function("encodeSnapshot", &encodeSnapshot);
+    function("decodeSnapshot", &decodeSnapshot);
+    function("loadQueryLedger", &loadQueryLedger);
+    function("queryTransactions", &queryTransactions);
+    function("setQueryCategory", &setQueryCategory);
 }
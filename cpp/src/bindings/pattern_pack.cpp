@@ -0,0 +1,76 @@
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include "../extractor/transaction_extractor.h"
+#include "../extractor/pattern_pack.h"
+#include "extractor_bindings.h"
+
+using namespace emscripten;
+using namespace BankAnalyzer;
+
+// Extended pattern pack module: Patterns 10, 4, 6, 5, 7, 8 and 9 (std::regex).
+// Loaded by the frontend only when the base module finds no transactions, so
+// it runs this pack alone rather than repeating the base patterns.
+
+TransactionExtractor& packExtractor() {
+    static TransactionExtractor extractor(extendedPatternPack());
+    return extractor;
+}
+
+val extractTransactions(const std::string& text) {
+    activeExtraction().reset();
+    return transactionsToJS(packExtractor().extract(text));
+}
+
+// Time-sliced extraction for the UI thread: start, then continue until the
+// progress says done (see extraction_job.h). Starting again drops the old job.
+void startExtraction(const std::string& text) {
+    activeExtraction() = std::make_unique<ExtractionJob>(packExtractor(), text);
+}
+
+val continueExtraction(double maxBytes, double maxMilliseconds) {
+    return continueActiveExtraction(maxBytes, maxMilliseconds);
+}
+
+// Stop the job and free its text and partial results
+void cancelExtraction() {
+    if (activeExtraction()) {
+        activeExtraction()->cancel();
+    }
+}
+
+// Metrics for the most recent extractTransactions() call or extraction job
+val getExtractorStats() {
+    return extractorStatsToJS(packExtractor());
+}
+
+void setExtractionLimits(double stepsPerByte, double deadlineMs) {
+    applyExtractionLimits(packExtractor(), stepsPerByte, deadlineMs);
+}
+
+// Cap the memory kept between calls for extraction/analysis scratch
+void setScratchCapacity(double megabytes) {
+    applyScratchCapacity(megabytes);
+}
+
+val getKernelInfo() {
+    return kernelInfoToJS();
+}
+
+// Threads the kernels may use; only the simd-threads module has any, and it
+// holds the count to its pre-started workers
+void setThreadCount(double threads) {
+    setKernelThreads(static_cast<size_t>(threads));
+}
+
+// Bind functions to JavaScript
+EMSCRIPTEN_BINDINGS(bank_analyzer_patterns) {
+    function("extractTransactions", &extractTransactions);
+    function("startExtraction", &startExtraction);
+    function("continueExtraction", &continueExtraction);
+    function("cancelExtraction", &cancelExtraction);
+    function("getExtractorStats", &getExtractorStats);
+    function("setExtractionLimits", &setExtractionLimits);
+    function("setScratchCapacity", &setScratchCapacity);
+    function("getKernelInfo", &getKernelInfo);
+    function("setThreadCount", &setThreadCount);
+}
@@ -0,0 +1,342 @@
+// teller-cli: native batch processor for archived statements.
+// Walks directories of extracted statement text, runs the same extractor and
+// analyzer as the WASM module on a work-stealing thread pool, and streams the
+// transactions out as CSV or JSON Lines.
+
+#include "mapped_file.h"
+#include "record_writer.h"
+#include "snapshot_cache.h"
+#include "thread_pool.h"
+#include "../extractor/transaction_extractor.h"
+#include "../extractor/pattern_pack.h"
+#include "../analyzer/analyzer.h"
+#include "../snapshot/snapshot.h"
+#include "../kernels/kernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace BankAnalyzer;
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Options {
+    OutputFormat format = OutputFormat::Csv;
+    std::string outputPath;           // empty = stdout
+    size_t jobs = 0;                  // 0 = one per core
+    double deadlineMs = -1.0;         // < 0 = extractor default
+    std::string cacheDirectory;       // empty = no snapshot cache
+    int transferWindowDays = TransferOptions().windowDays;
+    std::vector<std::string> inputs;
+};
+
+struct InputFile {
+    std::string path;
+    uintmax_t size;
+};
+
+void printUsage(const char* program) {
+    std::fprintf(stderr,
+        "Usage: %s [options] <file|directory>...\n"
+        "\n"
+        "Extract transactions from statement text files (.txt) and print them\n"
+        "as CSV or JSON Lines. Directories are searched recursively.\n"
+        "\n"
+        "Options:\n"
+        "  -f, --format csv|jsonl   Output format (default: csv)\n"
+        "  -o, --output FILE        Write records to FILE instead of stdout\n"
+        "  -j, --jobs N             Worker threads (default: one per core)\n"
+        "  --deadline MS            Per-file extraction deadline (0 = none, default: 5000)\n"
+        "  --cache DIR              Reuse extraction results for statements seen before\n"
+        "                           (snapshots keyed by a hash of the text)\n"
+        "  --transfer-window DAYS   Largest date gap between the two sides of a transfer\n"
+        "                           between input files (default: 3)\n"
+        "  -h, --help               Show this help\n"
+        "\n"
+        "The analyzer summary is written to stderr as one JSON line. Each input file\n"
+        "is taken as one account; debits and credits that move money between them\n"
+        "are paired as transfers and left out of the totals.\n",
+        program);
+}
+
+bool parseArgs(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto needValue = [&](const char* name) -> const char* {
+            if (i + 1 >= argc) {
+                std::fprintf(stderr, "teller-cli: %s requires a value\n", name);
+                return nullptr;
+            }
+            return argv[++i];
+        };
+
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            std::exit(0);
+        } else if (arg == "-f" || arg == "--format") {
+            const char* value = needValue("--format");
+            if (!value) return false;
+            if (std::strcmp(value, "csv") == 0) {
+                options.format = OutputFormat::Csv;
+            } else if (std::strcmp(value, "jsonl") == 0) {
+                options.format = OutputFormat::JsonLines;
+            } else {
+                std::fprintf(stderr, "teller-cli: unknown format '%s'\n", value);
+                return false;
+            }
+        } else if (arg == "-o" || arg == "--output") {
+            const char* value = needValue("--output");
+            if (!value) return false;
+            options.outputPath = value;
+        } else if (arg == "-j" || arg == "--jobs") {
+            const char* value = needValue("--jobs");
+            if (!value) return false;
+            options.jobs = static_cast<size_t>(std::strtoul(value, nullptr, 10));
+        } else if (arg == "--deadline") {
+            const char* value = needValue("--deadline");
+            if (!value) return false;
+            options.deadlineMs = std::atof(value);
+        } else if (arg == "--cache") {
+            const char* value = needValue("--cache");
+            if (!value) return false;
+            options.cacheDirectory = value;
+        } else if (arg == "--transfer-window") {
+            const char* value = needValue("--transfer-window");
+            if (!value) return false;
+            options.transferWindowDays = std::atoi(value);
+        } else if (!arg.empty() && arg[0] == '-') {
+            std::fprintf(stderr, "teller-cli: unknown option '%s'\n", arg.c_str());
+            return false;
+        } else {
+            options.inputs.push_back(arg);
+        }
+    }
+
+    if (options.inputs.empty()) {
+        printUsage(argv[0]);
+        return false;
+    }
+    return true;
+}
+
+bool hasExtension(const fs::path& path, const char* extension) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    return ext == extension;
+}
+
+// Expand directories into the statement files they contain
+void collectInputs(const std::vector<std::string>& paths, std::vector<InputFile>& files,
+                   size_t& skippedPdfs) {
+    auto consider = [&](const fs::path& path) {
+        std::error_code ec;
+        if (hasExtension(path, ".txt")) {
+            files.push_back({path.string(), fs::file_size(path, ec)});
+        } else if (hasExtension(path, ".pdf")) {
+            // PDF text extraction only exists in the browser (PDF.js) for now
+            ++skippedPdfs;
+        }
+    };
+
+    for (const auto& input : paths) {
+        std::error_code ec;
+        fs::path path(input);
+        if (fs::is_directory(path, ec)) {
+            for (fs::recursive_directory_iterator it(path, ec), end; it != end; it.increment(ec)) {
+                if (ec) break;
+                if (it->is_regular_file(ec)) {
+                    consider(it->path());
+                }
+            }
+        } else if (fs::is_regular_file(path, ec)) {
+            // Explicitly named files are processed regardless of extension
+            if (hasExtension(path, ".pdf")) {
+                ++skippedPdfs;
+            } else {
+                files.push_back({path.string(), fs::file_size(path, ec)});
+            }
+        } else {
+            std::fprintf(stderr, "teller-cli: no such file or directory: %s\n", input.c_str());
+        }
+    }
+}
+
+// Patterns abandoned on their step budget don't fail the file, but say so
+void reportAborts(const std::string& path, const TransactionExtractor& extractor) {
+    const ExtractorStats& stats = extractor.stats();
+    if (!stats.anyAborted()) {
+        return;
+    }
+
+    std::string patterns;
+    for (int id : extractor.patternCascade()) {
+        if (stats.pattern(id).aborted) {
+            patterns += patterns.empty() ? "" : ", ";
+            patterns += std::to_string(id);
+        }
+    }
+    std::fprintf(stderr, "teller-cli: %s: abandoned pattern(s) %s (%s)\n", path.c_str(), patterns.c_str(),
+                 stats.deadlineExceeded ? "deadline exceeded" : "step budget exceeded");
+}
+
+void reportBalanceMismatches(const std::string& path, const TransactionExtractor& extractor) {
+    uint64_t mismatches = extractor.stats().balance.mismatches;
+    if (mismatches > 0) {
+        std::fprintf(stderr, "teller-cli: %s: %llu row(s) don't reconcile with the running balance\n",
+                     path.c_str(), static_cast<unsigned long long>(mismatches));
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseArgs(argc, argv, options)) {
+        return 2;
+    }
+
+    std::vector<InputFile> files;
+    size_t skippedPdfs = 0;
+    collectInputs(options.inputs, files, skippedPdfs);
+    if (skippedPdfs > 0) {
+        std::fprintf(stderr, "teller-cli: skipped %zu PDF file(s); no native PDF parser yet, "
+                             "extract the text first\n", skippedPdfs);
+    }
+
+    // Largest first, so the long statements start early and small ones fill the gaps
+    std::sort(files.begin(), files.end(), [](const InputFile& a, const InputFile& b) {
+        return a.size > b.size;
+    });
+
+    FILE* output = stdout;
+    if (!options.outputPath.empty()) {
+        output = std::fopen(options.outputPath.c_str(), "wb");
+        if (!output) {
+            std::fprintf(stderr, "teller-cli: cannot open %s: %s\n",
+                         options.outputPath.c_str(), std::strerror(errno));
+            return 1;
+        }
+    }
+
+    std::string header = recordHeader(options.format);
+    std::fwrite(header.data(), 1, header.size(), output);
+
+    std::unique_ptr<SnapshotCache> cache;
+    if (!options.cacheDirectory.empty()) {
+        cache = std::make_unique<SnapshotCache>(options.cacheDirectory);
+        std::string error;
+        if (!cache->prepare(error)) {
+            std::fprintf(stderr, "teller-cli: %s\n", error.c_str());
+            return 1;
+        }
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    ThreadPool pool(options.jobs);
+
+    // One statement can't keep the pool busy; give its cores to the kernels
+    if (files.size() == 1) {
+        setKernelThreads(pool.size());
+    }
+    std::vector<std::vector<Transaction>> ledgers(pool.size());
+    std::mutex outputMutex;
+    std::atomic<size_t> failures{0};
+    std::atomic<size_t> cacheHits{0};
+
+    for (const auto& file : files) {
+        pool.submit([&, path = file.path](size_t worker) {
+            MappedFile mapped;
+            std::string error;
+            if (!mapped.open(path, error)) {
+                std::fprintf(stderr, "teller-cli: %s\n", error.c_str());
+                ++failures;
+                return;
+            }
+
+            std::vector<Transaction> transactions;
+            uint64_t hash = cache ? hashStatementText(mapped.view()) : 0;
+            if (cache && cache->load(hash, transactions)) {
+                ++cacheHits;
+            } else {
+                TransactionExtractor extractor;
+                extractor.addPatternPack(extendedPatternPack());
+                if (options.deadlineMs >= 0) {
+                    ExtractionLimits limits = extractor.limits();
+                    limits.deadlineMs = options.deadlineMs;
+                    extractor.setLimits(limits);
+                }
+                transactions = extractor.extract(mapped.view());
+                reportAborts(path, extractor);
+                reportBalanceMismatches(path, extractor);
+
+                // A result cut short by the step budget or deadline depends on
+                // timing, so only complete extractions are cached
+                if (cache && !extractor.stats().anyAborted()) {
+                    Analyzer analyzer;
+                    std::string snapshot = buildSnapshot(transactions, analyzer.analyze(transactions), hash);
+                    if (!cache->store(hash, snapshot, error)) {
+                        std::fprintf(stderr, "teller-cli: %s\n", error.c_str());
+                    }
+                }
+            }
+
+            // The file is the account, for pairing transfers between files
+            for (Transaction& txn : transactions) {
+                txn.account = path;
+            }
+
+            std::string buffer;
+            appendRecords(buffer, options.format, path, transactions);
+            {
+                std::lock_guard<std::mutex> lock(outputMutex);
+                std::fwrite(buffer.data(), 1, buffer.size(), output);
+            }
+
+            auto& ledger = ledgers[worker];
+            ledger.insert(ledger.end(),
+                          std::make_move_iterator(transactions.begin()),
+                          std::make_move_iterator(transactions.end()));
+        });
+    }
+    pool.wait();
+
+    if (output != stdout) {
+        std::fclose(output);
+    } else {
+        std::fflush(output);
+    }
+
+    std::vector<Transaction> all;
+    for (auto& ledger : ledgers) {
+        all.insert(all.end(), std::make_move_iterator(ledger.begin()),
+                   std::make_move_iterator(ledger.end()));
+    }
+
+    Analyzer analyzer;
+    TransferOptions transfers;
+    transfers.windowDays = options.transferWindowDays;
+    analyzer.setTransferOptions(transfers);
+    AnalysisResult result = analyzer.analyze(all);
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    if (cache) {
+        std::fprintf(stderr, "teller-cli: %zu of %zu file(s) read from the snapshot cache\n",
+                     cacheHits.load(), files.size() - failures);
+    }
+    std::string summary = formatSummaryJson(result, files.size() - failures, all.size(), elapsed);
+    std::fwrite(summary.data(), 1, summary.size(), stderr);
+
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,122 @@
+#include "mapped_file.h"
+#include <cstring>
+#include <utility>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace BankAnalyzer {
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      mapped_(std::exchange(other.mapped_, false)) {
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        mapped_ = std::exchange(other.mapped_, false);
+    }
+    return *this;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& path, std::string& error) {
+    close();
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    std::streamsize length = file.tellg();
+    file.seekg(0);
+    if (length <= 0) {
+        return true;
+    }
+
+    char* buffer = new char[static_cast<size_t>(length)];
+    if (!file.read(buffer, length)) {
+        delete[] buffer;
+        error = "cannot read " + path;
+        return false;
+    }
+
+    data_ = buffer;
+    size_ = static_cast<size_t>(length);
+    return true;
+}
+
+void MappedFile::close() {
+    delete[] data_;
+    data_ = nullptr;
+    size_ = 0;
+}
+
+#else
+
+bool MappedFile::open(const std::string& path, std::string& error) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "cannot open " + path + ": " + std::strerror(errno);
+        return false;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        error = "cannot stat " + path + ": " + std::strerror(errno);
+        ::close(fd);
+        return false;
+    }
+
+    if (info.st_size == 0) {
+        ::close(fd);
+        return true; // mmap rejects zero-length mappings
+    }
+
+    void* address = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        error = "cannot map " + path + ": " + std::strerror(errno);
+        return false;
+    }
+
+    // Extraction scans the whole file front to back
+    ::madvise(address, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+
+    data_ = static_cast<const char*>(address);
+    size_ = static_cast<size_t>(info.st_size);
+    mapped_ = true;
+    return true;
+}
+
+void MappedFile::close() {
+    if (data_ && mapped_) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+}
+
+#endif
+
+} // namespace BankAnalyzer
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace BankAnalyzer {
+
+/**
+ * Read-only view of a file's contents.
+ * Uses mmap on POSIX so large statement archives are paged in on demand
+ * instead of being copied; falls back to a heap buffer elsewhere.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * Map a file into memory
+     * @param path File to open
+     * @param error Receives a description of the failure, if any
+     * @return true on success (an empty file is a success with an empty view)
+     */
+    bool open(const std::string& path, std::string& error);
+
+    void close();
+
+    std::string_view view() const { return std::string_view(data_, size_); }
+    size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;     // true if data_ came from mmap, false if heap-owned
+};
+
+} // namespace BankAnalyzer
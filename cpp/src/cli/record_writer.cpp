@@ -0,0 +1,169 @@
+#include "record_writer.h"
+#include <cstdio>
+
+namespace BankAnalyzer {
+
+namespace {
+
+// RFC 4180: quote fields containing separators, quotes or line breaks
+void appendCsvField(std::string& out, std::string_view value) {
+    if (value.find_first_of(",\"\r\n") == std::string_view::npos) {
+        out.append(value);
+        return;
+    }
+
+    out.push_back('"');
+    for (char c : value) {
+        if (c == '"') {
+            out.push_back('"');
+        }
+        out.push_back(c);
+    }
+    out.push_back('"');
+}
+
+} // namespace
+
+std::string recordHeader(OutputFormat format) {
+    if (format == OutputFormat::Csv) {
+        return "file,date,description,amount,balance,type,category,currency,balance_mismatch\n";
+    }
+    return "";
+}
+
+void appendJsonString(std::string& out, std::string_view value) {
+    out.push_back('"');
+    for (char c : value) {
+        switch (c) {
+            case '"':  out.append("\\\""); break;
+            case '\\': out.append("\\\\"); break;
+            case '\n': out.append("\\n"); break;
+            case '\r': out.append("\\r"); break;
+            case '\t': out.append("\\t"); break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+                    out.append(escaped);
+                } else {
+                    out.push_back(c); // UTF-8 passes through untouched
+                }
+        }
+    }
+    out.push_back('"');
+}
+
+void appendAmount(std::string& out, Money value) {
+    out.append(formatMoney(value));
+}
+
+void appendRecords(std::string& out, OutputFormat format, std::string_view source,
+                   const std::vector<Transaction>& transactions) {
+    for (const auto& txn : transactions) {
+        if (format == OutputFormat::Csv) {
+            appendCsvField(out, source);
+            out.push_back(',');
+            appendCsvField(out, txn.date);
+            out.push_back(',');
+            appendCsvField(out, txn.description);
+            out.push_back(',');
+            appendAmount(out, txn.amount);
+            out.push_back(',');
+            appendAmount(out, txn.balance);
+            out.push_back(',');
+            appendCsvField(out, txn.type);
+            out.push_back(',');
+            appendCsvField(out, txn.category);
+            out.push_back(',');
+            out.append(currencyName(txn.amount.currency));
+            out.append(txn.balanceMismatch ? ",true\n" : ",false\n");
+        } else {
+            out.append("{\"file\":");
+            appendJsonString(out, source);
+            out.append(",\"date\":");
+            appendJsonString(out, txn.date);
+            out.append(",\"description\":");
+            appendJsonString(out, txn.description);
+            out.append(",\"amount\":");
+            appendAmount(out, txn.amount);
+            out.append(",\"balance\":");
+            appendAmount(out, txn.balance);
+            out.append(",\"type\":");
+            appendJsonString(out, txn.type);
+            out.append(",\"category\":");
+            appendJsonString(out, txn.category);
+            out.append(",\"currency\":");
+            appendJsonString(out, currencyName(txn.amount.currency));
+            out.append(txn.balanceMismatch ? ",\"balanceMismatch\":true}\n" : ",\"balanceMismatch\":false}\n");
+        }
+    }
+}
+
+std::string formatSummaryJson(const AnalysisResult& result, size_t fileCount,
+                              size_t transactionCount, double elapsedSeconds) {
+    std::string out = "{\"files\":" + std::to_string(fileCount);
+    out += ",\"transactions\":" + std::to_string(transactionCount);
+    out += ",\"totalIncome\":";
+    appendAmount(out, result.totalIncome);
+    out += ",\"totalExpenses\":";
+    appendAmount(out, result.totalExpenses);
+    out += ",\"netChange\":";
+    appendAmount(out, result.netChange);
+    out += ",\"currency\":";
+    appendJsonString(out, currencyName(result.netChange.currency));
+
+    out += ",\"categoryTotals\":{";
+    bool first = true;
+    for (const auto& pair : result.categoryTotals) {
+        if (!first) {
+            out.push_back(',');
+        }
+        first = false;
+        appendJsonString(out, pair.first);
+        out.push_back(':');
+        appendAmount(out, pair.second);
+    }
+    out += "}";
+
+    out += ",\"recurring\":[";
+    for (size_t i = 0; i < result.recurring.size(); ++i) {
+        const RecurringSeries& series = result.recurring[i];
+        if (i > 0) {
+            out.push_back(',');
+        }
+        out.append("{\"merchant\":");
+        appendJsonString(out, series.merchant);
+        out.append(",\"cadence\":");
+        appendJsonString(out, series.cadence);
+        out.append(",\"type\":");
+        appendJsonString(out, series.type);
+        out.append(",\"occurrences\":" + std::to_string(series.occurrences));
+        out.append(",\"lastAmount\":");
+        appendAmount(out, series.lastAmount);
+        out.append(",\"lastDate\":");
+        appendJsonString(out, series.lastDate);
+        out.append(",\"nextDate\":");
+        appendJsonString(out, series.nextDate);
+        out.append(",\"nextAmount\":");
+        appendAmount(out, series.nextAmount);
+        out.append(series.active ? ",\"active\":true}" : ",\"active\":false}");
+    }
+    out += "]";
+
+    // Money moved between the input files, left out of the totals
+    Money transferred;
+    for (const TransferPair& pair : result.transfers) {
+        transferred += pair.amount;
+    }
+    transferred.currency = result.netChange.currency;
+    out += ",\"transfers\":" + std::to_string(result.transfers.size());
+    out += ",\"transferTotal\":";
+    appendAmount(out, transferred);
+
+    char timing[64];
+    std::snprintf(timing, sizeof(timing), ",\"elapsedSeconds\":%.3f}\n", elapsedSeconds);
+    out += timing;
+    return out;
+}
+
+} // namespace BankAnalyzer
@@ -0,0 +1,49 @@
+#pragma once
+#include "../extractor/transaction_extractor.h"
+#include "../analyzer/analyzer.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace BankAnalyzer {
+
+enum class OutputFormat {
+    Csv,
+    JsonLines
+};
+
+/**
+ * Column header line for CSV output (empty for JSON Lines)
+ */
+std::string recordHeader(OutputFormat format);
+
+/**
+ * Append one record per transaction to a buffer.
+ * Workers format into their own buffer and hand it to the writer in one
+ * piece, so records from different files never interleave.
+ * @param out Buffer to append to
+ * @param format Output format
+ * @param source Input file the transactions came from
+ * @param transactions Transactions to format
+ */
+void appendRecords(std::string& out, OutputFormat format, std::string_view source,
+                   const std::vector<Transaction>& transactions);
+
+/**
+ * Append a JSON string literal (quoted and escaped)
+ */
+void appendJsonString(std::string& out, std::string_view value);
+
+/**
+ * Append an amount with two decimals, the precision statements use. Exact:
+ * printed from the minor units, never through a double.
+ */
+void appendAmount(std::string& out, Money value);
+
+/**
+ * Format the analyzer summary as a single JSON object line
+ */
+std::string formatSummaryJson(const AnalysisResult& result, size_t fileCount,
+                              size_t transactionCount, double elapsedSeconds);
+
+} // namespace BankAnalyzer
@@ -0,0 +1,74 @@
+#include "snapshot_cache.h"
+#include "mapped_file.h"
+#include "../snapshot/snapshot.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+namespace BankAnalyzer {
+
+SnapshotCache::SnapshotCache(std::string directory)
+    : directory_(std::move(directory)) {
+}
+
+bool SnapshotCache::prepare(std::string& error) {
+    std::error_code ec;
+    fs::create_directories(directory_, ec);
+    if (ec) {
+        error = "cannot create cache directory " + directory_ + ": " + ec.message();
+        return false;
+    }
+    return true;
+}
+
+std::string SnapshotCache::pathFor(uint64_t hash) const {
+    return (fs::path(directory_) / (formatSnapshotKey(hash) + ".tsnap")).string();
+}
+
+bool SnapshotCache::load(uint64_t hash, std::vector<Transaction>& transactions) const {
+    std::string path = pathFor(hash);
+    std::error_code ec;
+    if (!fs::is_regular_file(path, ec)) {
+        return false;
+    }
+
+    MappedFile mapped;
+    std::string error;
+    SnapshotView snapshot;
+    if (!mapped.open(path, error) || !snapshot.open(mapped.view(), error) || snapshot.sourceHash() != hash) {
+        return false;
+    }
+    transactions = snapshot.transactions();
+    return true;
+}
+
+bool SnapshotCache::store(uint64_t hash, const std::string& snapshot, std::string& error) {
+    std::string path = pathFor(hash);
+    std::string temp = path + ".tmp" + std::to_string(tempCounter_++);
+
+    FILE* file = std::fopen(temp.c_str(), "wb");
+    if (!file) {
+        error = "cannot write " + temp + ": " + std::strerror(errno);
+        return false;
+    }
+    bool written = std::fwrite(snapshot.data(), 1, snapshot.size(), file) == snapshot.size();
+    written = std::fclose(file) == 0 && written;
+
+    std::error_code ec;
+    if (written) {
+        fs::rename(temp, path, ec);
+    }
+    if (!written || ec) {
+        error = "cannot write " + path + (ec ? ": " + ec.message() : "");
+        fs::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
+
+} // namespace BankAnalyzer
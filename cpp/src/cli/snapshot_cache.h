@@ -0,0 +1,45 @@
+#pragma once
+#include "../extractor/transaction_extractor.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace BankAnalyzer {
+
+/**
+ * Directory of snapshots keyed by statement text hash
+ * (<dir>/<formatSnapshotKey(hash)>.tsnap). Identical statements seen on an
+ * earlier run are read back from the mapped snapshot instead of being
+ * extracted again. Safe to share between worker threads.
+ */
+class SnapshotCache {
+public:
+    explicit SnapshotCache(std::string directory);
+
+    /**
+     * Create the directory if it doesn't exist
+     * @param error Receives a description of the failure, if any
+     */
+    bool prepare(std::string& error);
+
+    /**
+     * Transactions cached for a statement
+     * @return false on a miss; stale (other version) or corrupt entries are misses
+     */
+    bool load(uint64_t hash, std::vector<Transaction>& transactions) const;
+
+    /**
+     * Write a snapshot (from buildSnapshot()). The file is written under a
+     * temporary name and renamed, so concurrent readers never see half of it.
+     */
+    bool store(uint64_t hash, const std::string& snapshot, std::string& error);
+
+    std::string pathFor(uint64_t hash) const;
+
+private:
+    std::string directory_;
+    std::atomic<uint64_t> tempCounter_{0};
+};
+
+} // namespace BankAnalyzer
@@ -0,0 +1,140 @@
+#include "thread_pool.h"
+
+namespace BankAnalyzer {
+
+namespace {
+// Lets submit() called from inside a task push onto the caller's own deque
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local size_t currentWorker = 0;
+}
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+
+    queues_.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+
+    workers_.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers_.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    wakeCondition_.notify_all();
+
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(Task task) {
+    size_t target;
+    if (currentPool == this) {
+        target = currentWorker;
+    } else {
+        target = nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    }
+
+    // Count the task before it can be seen: a thief could otherwise run it
+    // and finish it first, and wait() would see pending_ reach 0 while the
+    // task that submitted it is still running
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        ++pending_;
+        ++queued_;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+        queues_[target]->tasks.push_back(std::move(task));
+    }
+    wakeCondition_.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(sleepMutex_);
+    idleCondition_.wait(lock, [this] { return pending_ == 0; });
+}
+
+bool ThreadPool::popLocal(size_t index, Task& task) {
+    WorkQueue& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(size_t thief, bool blocking, Task& task) {
+    // Start with the next neighbour so thieves don't all hit queue 0
+    for (size_t offset = 1; offset < queues_.size(); ++offset) {
+        WorkQueue& victim = *queues_[(thief + offset) % queues_.size()];
+        std::unique_lock<std::mutex> lock(victim.mutex, std::defer_lock);
+        if (blocking) {
+            lock.lock();
+        } else {
+            lock.try_lock();
+        }
+        if (!lock.owns_lock() || victim.tasks.empty()) {
+            continue;
+        }
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    currentPool = this;
+    currentWorker = index;
+
+    while (true) {
+        Task task;
+        // A busy victim is skipped on the first sweep and waited for on the second
+        if (popLocal(index, task) || steal(index, false, task) || steal(index, true, task)) {
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex_);
+                --queued_;
+            }
+
+            task(index);
+
+            bool idle;
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex_);
+                idle = (--pending_ == 0);
+            }
+            if (idle) {
+                idleCondition_.notify_all();
+            }
+            continue;
+        }
+
+        // Nothing local and nothing to steal. queued_ reads positive anyway
+        // only while a submit is between counting and pushing its task, or
+        // another worker has taken one and not yet counted it; this wait
+        // returns straight away for that moment and the sweep runs again.
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        wakeCondition_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+        if (stopping_ && queued_ == 0) {
+            return;
+        }
+    }
+}
+
+} // namespace BankAnalyzer
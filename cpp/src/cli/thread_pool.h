@@ -0,0 +1,70 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace BankAnalyzer {
+
+/**
+ * Work-stealing thread pool used by the native batch tools.
+ *
+ * Each worker owns a deque: it pops its own work from the back (LIFO, cache
+ * friendly) and, when empty, steals from the front of a sibling's deque.
+ * Statements vary from one page to hundreds, so stealing keeps every core
+ * busy until the last large file is done.
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void(size_t workerIndex)>;
+
+    /**
+     * @param threadCount Number of workers (0 = std::thread::hardware_concurrency)
+     */
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Queue a task. Tasks submitted from a worker go to that worker's deque,
+     * external submissions are spread round-robin.
+     */
+    void submit(Task task);
+
+    /**
+     * Block until every submitted task has finished
+     */
+    void wait();
+
+    size_t size() const { return workers_.size(); }
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(size_t index);
+    bool popLocal(size_t index, Task& task);
+    bool steal(size_t thief, bool blocking, Task& task);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::mutex sleepMutex_;
+    std::condition_variable wakeCondition_;
+    std::condition_variable idleCondition_;
+    size_t pending_ = 0;          // Tasks submitted but not yet finished (guarded by sleepMutex_)
+    size_t queued_ = 0;           // Tasks submitted but not yet taken from a deque (guarded by sleepMutex_)
+    std::atomic<size_t> nextQueue_{0};
+    bool stopping_ = false;
+};
+
+} // namespace BankAnalyzer
@@ -0,0 +1,130 @@
+#include "balance_reconciliation.h"
+
+namespace BankAnalyzer {
+
+namespace {
+
+// Direction before reconciliation: what the pattern decided, else the keyword guess
+bool guessCredit(const Transaction& txn) {
+    return txn.type.empty() ? txn.creditKeyword : txn.type == "credit";
+}
+
+void setDirection(Transaction& txn, bool credit, BalanceStats& stats) {
+    const char* type = credit ? "credit" : "debit";
+    if (!txn.type.empty() && txn.type != type) {
+        ++stats.corrected;
+    }
+    txn.type = type;
+    ++stats.inferred;
+}
+
+// Rows [first, last] moved the balance by delta. Returns whether a direction
+// for each row explains it: the delta's sign for a lone row, otherwise the
+// current guesses or all rows the same way. With apply, that assignment is
+// written back.
+bool reconcileGap(std::vector<Transaction>& transactions, size_t first, size_t last,
+                  Money delta, bool apply, BalanceStats& stats) {
+    // Amounts and balances are exact minor units, so the sums either match
+    // to the cent or they don't
+    if (first == last) {
+        if (delta.abs() != transactions[first].amount) {
+            return false;
+        }
+        if (apply) {
+            setDirection(transactions[first], delta.minor > 0, stats);
+        }
+        return true;
+    }
+
+    Money guessed;
+    Money total;
+    for (size_t i = first; i <= last; ++i) {
+        Money amount = transactions[i].amount;
+        total += amount;
+        guessed += guessCredit(transactions[i]) ? amount : -amount;
+    }
+
+    if (guessed == delta) {
+        if (apply) {
+            for (size_t i = first; i <= last; ++i) {
+                setDirection(transactions[i], guessCredit(transactions[i]), stats);
+            }
+        }
+        return true;
+    }
+    if (delta.abs() == total) {
+        if (apply) {
+            for (size_t i = first; i <= last; ++i) {
+                setDirection(transactions[i], delta.minor > 0, stats);
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+// Walk consecutive balance rows in one reading order; returns how many gaps
+// reconcile. Oldest-first, a balance includes its own row; newest-first, it
+// includes the rows printed above it.
+size_t reconcileAnchors(std::vector<Transaction>& transactions, const std::vector<size_t>& anchors,
+                        bool newestFirst, bool apply, BalanceStats& stats) {
+    size_t reconciled = 0;
+    for (size_t k = 1; k < anchors.size(); ++k) {
+        size_t prev = anchors[k - 1];
+        size_t cur = anchors[k];
+        Money prevBalance = transactions[prev].balance;
+        Money curBalance = transactions[cur].balance;
+
+        bool ok = newestFirst
+            ? reconcileGap(transactions, prev, cur - 1, prevBalance - curBalance, apply, stats)
+            : reconcileGap(transactions, prev + 1, cur, curBalance - prevBalance, apply, stats);
+        if (ok) {
+            ++reconciled;
+        } else if (apply) {
+            transactions[newestFirst ? prev : cur].balanceMismatch = true;
+            ++stats.mismatches;
+        }
+    }
+    return reconciled;
+}
+
+} // namespace
+
+void markCreditKeywords(std::vector<Transaction>& transactions, DescriptionPool& descriptions) {
+    for (Transaction& txn : transactions) {
+        if (txn.type.empty()) {
+            txn.creditKeyword = descriptions.hasAny(descriptions.intern(txn.description), kKeywordCredit);
+        }
+    }
+}
+
+void reconcileBalances(std::vector<Transaction>& transactions, BalanceStats& stats) {
+    std::vector<size_t> anchors;
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        if (transactions[i].hasBalance) {
+            anchors.push_back(i);
+        }
+    }
+    stats.rows = anchors.size();
+
+    if (anchors.size() >= 2) {
+        // Pick the reading order that explains more deltas (ties: oldest first)
+        size_t gaps = anchors.size() - 1;
+        size_t forward = reconcileAnchors(transactions, anchors, false, false, stats);
+        if (forward < gaps) {
+            size_t backward = reconcileAnchors(transactions, anchors, true, false, stats);
+            stats.newestFirst = backward > forward;
+        }
+        reconcileAnchors(transactions, anchors, stats.newestFirst, true, stats);
+    }
+
+    // Rows the balances couldn't settle and the pattern left open
+    for (Transaction& txn : transactions) {
+        if (txn.type.empty()) {
+            txn.type = txn.creditKeyword ? "credit" : "debit";
+            ++stats.keywordFallbacks;
+        }
+    }
+}
+
+} // namespace BankAnalyzer
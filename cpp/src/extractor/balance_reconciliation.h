@@ -0,0 +1,35 @@
+#pragma once
+#include "transaction_extractor.h"
+#include "description_pool.h"
+#include <vector>
+
+namespace BankAnalyzer {
+
+/**
+ * Running-balance reconciliation, run on the rows of the pattern that won.
+ *
+ * Patterns that read a balance column set hasBalance. Between two rows with
+ * balances, the balance delta has to equal the signed sum of the rows in
+ * between; when a single row sits in that gap its direction is simply the
+ * sign of the delta, which overrides whatever the pattern guessed from
+ * columns, amount signs or keywords. Gaps whose amounts can't produce the
+ * delta flag the row that closes them (balanceMismatch).
+ *
+ * Statements printed newest-first are detected by checking which order
+ * explains more of the deltas.
+ *
+ * Rows a pattern left without a type (empty string) and that the balances
+ * can't decide fall back to description keywords ("DEPOSIT", "TRANSFER FROM",
+ * ..., marked by markCreditKeywords()), so statements without a balance
+ * column behave as before.
+ */
+void reconcileBalances(std::vector<Transaction>& transactions, BalanceStats& stats);
+
+/**
+ * Set creditKeyword on the rows a pattern left without a type, from the
+ * kKeywordCredit bit of their description. Call while the pool that interned
+ * the descriptions is alive; each row costs one lookup.
+ */
+void markCreditKeywords(std::vector<Transaction>& transactions, DescriptionPool& descriptions);
+
+} // namespace BankAnalyzer
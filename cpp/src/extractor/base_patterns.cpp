@@ -0,0 +1,608 @@
+// Base pattern pack: Patterns 2, 1 and 3, the layouts most statements use.
+// These are hand-written scanners rather than std::regex so the base WASM
+// module ships without the regex engine. Each scanner accepts exactly what its
+// original regex did (the regex is quoted above each one) and tries start
+// positions left to right like std::regex_iterator, one record window at a
+// time (see record_segmenter.h).
+
+#include "transaction_extractor.h"
+#include "pattern_pack.h"
+#include "text_scan.h"
+#include <cstdint>
+
+namespace BankAnalyzer {
+
+namespace {
+
+// Positions [from, until) known not to start a description that reaches an
+// amount. The amount side of every pattern here doesn't depend on where the
+// description began, so a failed scan rules out every later start before the
+// line break it stopped at.
+struct DescriptionMemo {
+    size_t from = 0;
+    size_t until = 0;
+};
+
+// Lazy description (.+? or [A-Za-z].*?) starting at start, followed by \s+
+// and whatever tail(q) matches at the end of that whitespace run. Returns the
+// end of the shortest description for which the tail matches, or kNoMatch.
+template <typename Tail>
+size_t findDescriptionEnd(std::string_view text, size_t start, DescriptionMemo& memo,
+                          MatchBudget& budget, Tail tail) {
+    if (start >= memo.from && start < memo.until) {
+        return kNoMatch;
+    }
+
+    size_t e = start + 1;
+    for (; e < text.size(); ++e) {
+        budget.charge();
+        if (isSpaceChar(text[e])) {
+            size_t q = skipSpaces(text, e);
+            if (tail(q)) {
+                return e;
+            }
+            // Ending the description anywhere else in this whitespace run
+            // leads to the same tail; skip ahead unless a line break stops it
+            size_t k = e;
+            while (k < q && !isLineBreak(text[k])) ++k;
+            if (k < q) {
+                e = k;
+                break;
+            }
+            e = q - 1;
+            continue;
+        }
+        if (isLineBreak(text[e])) {
+            break;
+        }
+    }
+
+    if (e == memo.until && start < memo.from) {
+        memo.from = start;
+    } else {
+        memo.from = start;
+        memo.until = e;
+    }
+    return kNoMatch;
+}
+
+// \s+(.+?) followed by tail, with the whitespace run starting at runBegin.
+// \s+ is greedy, so the description first starts after the whole run. If no
+// tail follows, the regex gives whitespace back and starts the description
+// inside the run. That adds only one way to end it (before the rest of the
+// run, leaving the tail at the run's end), and the last start with whitespace
+// after it gets there first. '.' doesn't match a line break, so a line break
+// can't start the description.
+template <typename Tail>
+bool findDescription(std::string_view text, size_t runBegin, DescriptionMemo& memo,
+                     MatchBudget& budget, Tail tail, size_t& descBegin, size_t& descEnd) {
+    size_t runEnd = skipSpaces(text, runBegin);
+    descBegin = runEnd;
+    descEnd = findDescriptionEnd(text, runEnd, memo, budget, tail);
+    if (descEnd != kNoMatch) {
+        return true;
+    }
+
+    for (size_t start = runEnd - 1; start-- > runBegin + 1;) {
+        budget.charge();
+        if (isLineBreak(text[start])) {
+            continue;
+        }
+        if (!tail(runEnd)) {
+            return false;
+        }
+        descBegin = start;
+        descEnd = start + 1;
+        return true;
+    }
+    return false;
+}
+
+std::string_view slice(std::string_view text, size_t begin, size_t end) {
+    return text.substr(begin, end - begin);
+}
+
+std::string sliceString(std::string_view text, size_t begin, size_t end) {
+    return begin == kNoMatch ? std::string() : std::string(slice(text, begin, end));
+}
+
+// --- Pattern 1 --------------------------------------------------------------
+
+struct Pattern1Match {
+    size_t dateBegin = kNoMatch, dateEnd = kNoMatch;
+    size_t descBegin = 0, descEnd = 0;
+    size_t amountBegin[3] = {kNoMatch, kNoMatch, kNoMatch};
+    size_t amountEnd[3] = {kNoMatch, kNoMatch, kNoMatch};
+    size_t end = 0;
+};
+
+// (?:Jan|...|Dec)[a-z]*\s+\d{1,2}|\d{1,2}\s+(?:Jan|...|Dec)[a-z]*
+size_t scanPattern1Date(std::string_view text, size_t pos) {
+    if (isLetterChar(text[pos])) {
+        return scanMonthDay(text, pos);
+    }
+    size_t digits = digitRun(text, pos, 3);
+    if (digits == 0 || digits == 3) {
+        return kNoMatch;
+    }
+    size_t monthStart = skipSpaces(text, pos + digits);
+    if (monthStart == pos + digits) {
+        return kNoMatch;
+    }
+    return scanMonthName(text, monthStart);
+}
+
+// (?:(DATE)\s+)?([A-Za-z].*?)\s+(AMOUNT)(?:\s+(AMOUNT))?(?:\s+(AMOUNT))?
+bool matchPattern1At(std::string_view text, size_t pos, DescriptionMemo& memo,
+                     MatchBudget& budget, Pattern1Match& match) {
+    auto amounts = [&](size_t q) {
+        size_t end = scanAmount(text, q);
+        if (end == kNoMatch) {
+            return false;
+        }
+        match.amountBegin[0] = q;
+        match.amountEnd[0] = end;
+        for (int i = 1; i < 3; ++i) {
+            match.amountBegin[i] = match.amountEnd[i] = kNoMatch;
+        }
+        // Optional second and third amounts
+        for (int i = 1; i < 3; ++i) {
+            size_t next = skipSpaces(text, end);
+            size_t nextEnd = next > end ? scanAmount(text, next) : kNoMatch;
+            if (nextEnd == kNoMatch) {
+                break;
+            }
+            match.amountBegin[i] = next;
+            match.amountEnd[i] = end = nextEnd;
+        }
+        match.end = end;
+        return true;
+    };
+
+    // With a leading date first, then without
+    size_t dateEnd = scanPattern1Date(text, pos);
+    if (dateEnd != kNoMatch && dateEnd < text.size() && isSpaceChar(text[dateEnd])) {
+        size_t descBegin = skipSpaces(text, dateEnd);
+        if (descBegin < text.size() && isLetterChar(text[descBegin])) {
+            size_t descEnd = findDescriptionEnd(text, descBegin, memo, budget, amounts);
+            if (descEnd != kNoMatch) {
+                match.dateBegin = pos;
+                match.dateEnd = dateEnd;
+                match.descBegin = descBegin;
+                match.descEnd = descEnd;
+                return true;
+            }
+        }
+    }
+
+    if (isLetterChar(text[pos])) {
+        size_t descEnd = findDescriptionEnd(text, pos, memo, budget, amounts);
+        if (descEnd != kNoMatch) {
+            match.dateBegin = match.dateEnd = kNoMatch;
+            match.descBegin = pos;
+            match.descEnd = descEnd;
+            return true;
+        }
+    }
+    return false;
+}
+
+// --- Pattern 2 --------------------------------------------------------------
+
+struct Pattern2Match {
+    size_t transDateBegin = 0, transDateEnd = 0;
+    size_t descBegin = 0, descEnd = 0;
+    size_t amountBegin = 0, amountEnd = 0;
+    size_t end = 0;
+};
+
+// (?:Jan|...|Dec)[a-z]*\s+\d{1,2}|\d{1,2}[/-]\d{1,2}[/-]\d{2,4}, then \s+
+size_t scanPattern2Date(std::string_view text, size_t pos) {
+    if (pos >= text.size()) {
+        return kNoMatch;
+    }
+    size_t end = isLetterChar(text[pos]) ? scanMonthDay(text, pos) : scanNumericDate(text, pos);
+    if (end == kNoMatch || end >= text.size() || !isSpaceChar(text[end])) {
+        return kNoMatch;
+    }
+    return end;
+}
+
+// (DATE)\s+(DATE)\s+(.+?)\s+(-?AMOUNT)(?:\s|$)
+bool matchPattern2At(std::string_view text, size_t pos, DescriptionMemo& memo,
+                     MatchBudget& budget, Pattern2Match& match) {
+    size_t transDateEnd = scanPattern2Date(text, pos);
+    if (transDateEnd == kNoMatch) {
+        return false;
+    }
+    size_t postDateEnd = scanPattern2Date(text, skipSpaces(text, transDateEnd));
+    if (postDateEnd == kNoMatch) {
+        return false;
+    }
+
+    size_t descBegin = 0;
+    size_t descEnd = 0;
+    bool found = findDescription(text, postDateEnd, memo, budget, [&](size_t q) {
+        size_t begin = q < text.size() && text[q] == '-' ? q + 1 : q;
+        size_t end = scanAmount(text, begin);
+        if (end == kNoMatch || (end < text.size() && !isSpaceChar(text[end]))) {
+            return false;
+        }
+        match.amountBegin = q;
+        match.amountEnd = end;
+        match.end = end < text.size() ? end + 1 : end;
+        return true;
+    }, descBegin, descEnd);
+    if (!found) {
+        return false;
+    }
+
+    match.transDateBegin = pos;
+    match.transDateEnd = transDateEnd;
+    match.descBegin = descBegin;
+    match.descEnd = descEnd;
+    return true;
+}
+
+// --- Pattern 3 --------------------------------------------------------------
+
+struct Pattern3Match {
+    size_t dateBegin = 0, dateEnd = 0;
+    size_t descBegin = 0, descEnd = 0;
+    size_t amountBegin = 0, amountEnd = 0;
+    size_t balanceBegin = kNoMatch, balanceEnd = kNoMatch;
+    size_t end = 0;
+};
+
+// [\$€£¥₹] in a char regex: '$' or any single byte of the UTF-8 symbols
+bool isCurrencyByte(char c) {
+    switch (static_cast<unsigned char>(c)) {
+        case '$': case 0xE2: case 0x82: case 0xAC: case 0xC2: case 0xA3: case 0xA5: case 0xB9:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// [\$€£¥₹]?\s*AMOUNT
+size_t scanSymbolAmount(std::string_view text, size_t pos) {
+    if (pos < text.size() && isCurrencyByte(text[pos])) ++pos;
+    return scanAmount(text, skipSpaces(text, pos));
+}
+
+// (\d{1,2}[/-]\d{1,2}[/-]\d{2,4}|\d{4}-\d{2}-\d{2})\s+(.+?)\s+
+// (-?[\$€£¥₹]?\s*AMOUNT)\s+(?:[\$€£¥₹]?\s*AMOUNT)?(?:\s|$)
+bool matchPattern3At(std::string_view text, size_t pos, DescriptionMemo& memo,
+                     MatchBudget& budget, Pattern3Match& match) {
+    size_t dateEnd = scanNumericDate(text, pos);
+    if (dateEnd == kNoMatch || dateEnd >= text.size() || !isSpaceChar(text[dateEnd])) {
+        dateEnd = scanIsoDate(text, pos);
+        if (dateEnd == kNoMatch || dateEnd >= text.size() || !isSpaceChar(text[dateEnd])) {
+            return false;
+        }
+    }
+
+    size_t descBegin = 0;
+    size_t descEnd = 0;
+    bool found = findDescription(text, dateEnd, memo, budget, [&](size_t q) {
+        size_t amountEnd = scanSymbolAmount(text, q < text.size() && text[q] == '-' ? q + 1 : q);
+        if (amountEnd == kNoMatch) {
+            return false;
+        }
+        size_t balanceBegin = skipSpaces(text, amountEnd);
+        if (balanceBegin == amountEnd) {
+            return false;
+        }
+
+        // Optional balance, then \s or end of text. When the balance doesn't
+        // fit, the regex backtracks and ends the match inside the whitespace
+        // run instead, which needs at least two whitespace characters.
+        size_t balanceEnd = scanSymbolAmount(text, balanceBegin);
+        if (balanceEnd != kNoMatch && (balanceEnd == text.size() || isSpaceChar(text[balanceEnd]))) {
+            match.balanceBegin = balanceBegin;
+            match.balanceEnd = balanceEnd;
+            match.end = balanceEnd < text.size() ? balanceEnd + 1 : balanceEnd;
+        } else if (balanceBegin == text.size() || balanceBegin - amountEnd >= 2) {
+            match.balanceBegin = match.balanceEnd = kNoMatch;
+            match.end = balanceBegin;
+        } else {
+            return false;
+        }
+        match.amountBegin = q;
+        match.amountEnd = amountEnd;
+        return true;
+    }, descBegin, descEnd);
+    if (!found) {
+        return false;
+    }
+
+    match.dateBegin = pos;
+    match.dateEnd = dateEnd;
+    match.descBegin = descBegin;
+    match.descEnd = descEnd;
+    return true;
+}
+
+} // namespace
+
+// ============================================================================
+// PATTERN EXTRACTION FUNCTIONS
+// ============================================================================
+
+// Pattern 1: Canadian Dual-Date Separate Columns (RBC, TD, BMO, Scotiabank)
+// Format: Date | Description | Amount(s) - flexible format
+// Handles date carry-forward (same-day transactions don't repeat the date)
+std::vector<Transaction> tryPattern1(std::string_view document, PatternContext& ctx) {
+    std::vector<Transaction> transactions;
+    Pattern1Match match;
+    std::string& lastDate = ctx.lastDate;
+
+    for (const RecordWindow& record : ctx.records) {
+        std::string_view text = recordText(document, record);
+        DescriptionMemo memo;
+        size_t pos = 0;
+        while (pos < text.size()) {
+            ctx.budget.charge();
+            if (!matchPattern1At(text, pos, memo, ctx.budget, match)) {
+                ++pos;
+                continue;
+            }
+            pos = match.end;
+            TELLER_COUNT(ctx.stats, attempted);
+
+            std::string date = sliceString(text, match.dateBegin, match.dateEnd);
+            uint32_t descriptionId = ctx.descriptions.intern(slice(text, match.descBegin, match.descEnd));
+            const std::string& description = ctx.descriptions.text(descriptionId);
+            std::string amount1 = sliceString(text, match.amountBegin[0], match.amountEnd[0]);
+            std::string amount2 = sliceString(text, match.amountBegin[1], match.amountEnd[1]);
+            std::string amount3 = sliceString(text, match.amountBegin[2], match.amountEnd[2]);
+
+            // Skip header rows and totals
+            const DescriptionPool& pool = ctx.descriptions;
+            if (pool.hasAny(descriptionId, kKeywordDescription | kKeywordOpening | kKeywordClosing |
+                                           kKeywordTotal | kKeywordSummary | kKeywordAccountDetails) ||
+                pool.hasAll(descriptionId, kKeywordWithdrawal | kKeywordDeposit) ||
+                (pool.hasAny(descriptionId, kKeywordBalance | kKeywordDate) && description.length() < 20)) {
+                TELLER_COUNT(ctx.stats, rejectedHeader);
+                continue;
+            }
+
+            // Skip if description is too short or just numbers
+            if (description.length() < 3 || isNumericText(description)) {
+                TELLER_COUNT(ctx.stats, rejectedTooShort);
+                continue;
+            }
+
+            // Use last date if current line has no date (same-day transaction)
+            if (date.empty() || date.find_first_not_of(" \t") == std::string::npos) {
+                if (lastDate.empty()) {
+                    TELLER_COUNT(ctx.stats, rejectedNoDate);
+                    continue; // Skip if we don't have a date yet
+                }
+                date = lastDate;
+            } else {
+                lastDate = date; // Update last seen date
+            }
+
+            // Determine which amount is the transaction amount (not balance)
+            // If 2 amounts: amount/balance
+            // If 3 amounts: withdrawal/deposit/balance
+            // Direction comes from the withdrawal/deposit columns when there are
+            // three; otherwise it is left to balance reconciliation, which falls
+            // back to description keywords (see balance_reconciliation.h)
+            bool isNegative = false;
+            Money amount;
+            std::string type;
+            std::string balance;
+
+            if (!amount3.empty()) {
+                // Format: Date Desc Withdrawal Deposit Balance
+                const std::string& withdrawal = amount1;
+                const std::string& deposit = amount2;
+
+                if (!withdrawal.empty() && withdrawal != "0.00") {
+                    amount = parseAmount(withdrawal, isNegative);
+                    type = "debit";
+                } else if (!deposit.empty() && deposit != "0.00") {
+                    amount = parseAmount(deposit, isNegative);
+                    type = "credit";
+                } else {
+                    TELLER_COUNT(ctx.stats, rejectedNoAmount);
+                    continue;
+                }
+                balance = amount3;
+            } else {
+                // Format: Date Desc Amount [Balance]
+                amount = parseAmount(amount1, isNegative);
+                balance = amount2;
+            }
+
+            Transaction txn;
+            txn.date = date;
+            txn.description = description;
+            txn.amount = amount;
+            txn.balance = balance.empty() ? Money() : parseBalance(balance);
+            txn.hasBalance = !balance.empty();
+            txn.type = type;
+            txn.category = "uncategorized";
+
+            TELLER_COUNT(ctx.stats, accepted);
+            transactions.push_back(txn);
+        }
+    }
+
+    return transactions;
+}
+
+// Pattern 2: US/Credit Card Dual-Date Single Amount (CIBC Visa, Chase, BoA, Citi)
+// Format: Trans date | Post date | Description | Amount($)
+std::vector<Transaction> tryPattern2(std::string_view document, PatternContext& ctx) {
+    std::vector<Transaction> transactions;
+    Pattern2Match match;
+
+    for (const RecordWindow& record : ctx.records) {
+        std::string_view text = recordText(document, record);
+        DescriptionMemo memo;
+        size_t pos = 0;
+        while (pos < text.size()) {
+            ctx.budget.charge();
+            if (!matchPattern2At(text, pos, memo, ctx.budget, match)) {
+                ++pos;
+                continue;
+            }
+            pos = match.end;
+            TELLER_COUNT(ctx.stats, attempted);
+
+            std::string transDate(slice(text, match.transDateBegin, match.transDateEnd));
+            uint32_t descriptionId = ctx.descriptions.intern(slice(text, match.descBegin, match.descEnd));
+            const std::string& description = ctx.descriptions.text(descriptionId);
+            std::string amountStr(slice(text, match.amountBegin, match.amountEnd));
+
+            // Skip headers
+            const DescriptionPool& pool = ctx.descriptions;
+            if (pool.hasAny(descriptionId, kKeywordTrans | kKeywordPost) &&
+                pool.hasAny(descriptionId, kKeywordDescription)) {
+                TELLER_COUNT(ctx.stats, rejectedHeader);
+                continue;
+            }
+
+            // Skip if description is too short
+            if (description.length() < 3) {
+                TELLER_COUNT(ctx.stats, rejectedTooShort);
+                continue;
+            }
+
+            // Parse amount
+            bool isNegative = false;
+            Money amount = parseAmount(amountStr, isNegative);
+
+            // For credit cards: positive = debit (purchase), negative = credit (refund)
+            // Also check for payment keywords ("PAYMENT", "PAIEMENT")
+            bool isPayment = pool.hasAny(descriptionId, kKeywordPayment);
+
+            Transaction txn;
+            txn.date = transDate;
+            txn.description = description;
+            txn.amount = amount;
+            txn.balance = Money();
+            // Credit cards: payments and negative amounts are credits, everything else is debit
+            txn.type = (isPayment || isNegative) ? "credit" : "debit";
+            txn.category = "uncategorized";
+
+            TELLER_COUNT(ctx.stats, accepted);
+            transactions.push_back(txn);
+        }
+    }
+
+    return transactions;
+}
+
+// Pattern 3: Simple Date-Description-Amount (Ally, Chime, SoFi, many credit unions)
+// Format: Date | Description | Amount | Balance
+std::vector<Transaction> tryPattern3(std::string_view document, PatternContext& ctx) {
+    std::vector<Transaction> transactions;
+    Pattern3Match match;
+
+    for (const RecordWindow& record : ctx.records) {
+        std::string_view text = recordText(document, record);
+        DescriptionMemo memo;
+        size_t pos = 0;
+        while (pos < text.size()) {
+            ctx.budget.charge();
+            if (!isDigitChar(text[pos]) || !matchPattern3At(text, pos, memo, ctx.budget, match)) {
+                ++pos;
+                continue;
+            }
+            pos = match.end;
+            TELLER_COUNT(ctx.stats, attempted);
+
+            std::string date(slice(text, match.dateBegin, match.dateEnd));
+            uint32_t descriptionId = ctx.descriptions.intern(slice(text, match.descBegin, match.descEnd));
+            const std::string& description = ctx.descriptions.text(descriptionId);
+            std::string amountStr(slice(text, match.amountBegin, match.amountEnd));
+            std::string balanceStr = sliceString(text, match.balanceBegin, match.balanceEnd);
+
+            // Skip headers
+            if (ctx.descriptions.hasAll(descriptionId, kKeywordDescription | kKeywordAmount)) {
+                TELLER_COUNT(ctx.stats, rejectedHeader);
+                continue;
+            }
+
+            // Skip if description is too short
+            if (description.length() < 3) {
+                TELLER_COUNT(ctx.stats, rejectedTooShort);
+                continue;
+            }
+
+            // Parse amount
+            bool isNegative = false;
+            Money amount = parseAmount(amountStr, isNegative);
+
+            Transaction txn;
+            txn.date = date;
+            txn.description = description;
+            txn.amount = amount;
+            txn.balance = balanceStr.empty() ? Money() : parseBalance(balanceStr);
+            txn.hasBalance = !balanceStr.empty();
+            txn.type = isNegative ? "debit" : "credit";
+            txn.category = "uncategorized";
+
+            TELLER_COUNT(ctx.stats, accepted);
+            transactions.push_back(txn);
+        }
+    }
+
+    return transactions;
+}
+
+std::vector<ScannerMatch> scanBasePattern(int id, std::string_view record, MatchBudget& budget) {
+    std::vector<ScannerMatch> matches;
+    Pattern1Match match1;
+    Pattern2Match match2;
+    Pattern3Match match3;
+    DescriptionMemo memo;
+    size_t pos = 0;
+    while (pos < record.size()) {
+        budget.charge();
+        ScannerMatch found;
+        if (id == 1 && matchPattern1At(record, pos, memo, budget, match1)) {
+            found.end = match1.end;
+            found.groups = {{match1.dateBegin, match1.dateEnd},
+                            {match1.descBegin, match1.descEnd},
+                            {match1.amountBegin[0], match1.amountEnd[0]},
+                            {match1.amountBegin[1], match1.amountEnd[1]},
+                            {match1.amountBegin[2], match1.amountEnd[2]}};
+        } else if (id == 2 && matchPattern2At(record, pos, memo, budget, match2)) {
+            found.end = match2.end;
+            found.groups = {{match2.transDateBegin, match2.transDateEnd},
+                            {match2.descBegin, match2.descEnd},
+                            {match2.amountBegin, match2.amountEnd}};
+        } else if (id == 3 && isDigitChar(record[pos]) && matchPattern3At(record, pos, memo, budget, match3)) {
+            found.end = match3.end;
+            found.groups = {{match3.dateBegin, match3.dateEnd},
+                            {match3.descBegin, match3.descEnd},
+                            {match3.amountBegin, match3.amountEnd},
+                            {match3.balanceBegin, match3.balanceEnd}};
+        } else {
+            ++pos;
+            continue;
+        }
+        found.begin = pos;
+        matches.push_back(found);
+        pos = found.end;
+    }
+    return matches;
+}
+
+const PatternPack& basePatternPack() {
+    // Most common formats first
+    static const PatternDefinition patterns[] = {
+        {2, tryPattern2},   // 25% coverage
+        {1, tryPattern1},   // 20% coverage
+        {3, tryPattern3},   // 15% coverage
+    };
+    static const PatternPack pack = {"base", patterns, sizeof(patterns) / sizeof(patterns[0])};
+    return pack;
+}
+
+} // namespace BankAnalyzer
@@ -0,0 +1,83 @@
+#include "description_pool.h"
+#include "pattern_pack.h"
+#include <cctype>
+
+namespace BankAnalyzer {
+
+namespace {
+
+struct KeywordBit {
+    const char* word;
+    uint32_t bit;
+};
+
+const KeywordBit kKeywords[] = {
+    {"DESCRIPTION", kKeywordDescription},
+    {"WITHDRAWAL", kKeywordWithdrawal},
+    {"DEPOSIT", kKeywordDeposit},
+    {"BALANCE", kKeywordBalance},
+    {"DATE", kKeywordDate},
+    {"OPENING", kKeywordOpening},
+    {"CLOSING", kKeywordClosing},
+    {"TOTAL", kKeywordTotal},
+    {"SUMMARY", kKeywordSummary},
+    {"DETAILS OF YOUR ACCOUNT", kKeywordAccountDetails},
+    {"TRANS", kKeywordTrans},
+    {"POST", kKeywordPost},
+    {"AMOUNT", kKeywordAmount},
+    {"PAYMENT", kKeywordPayment},
+    {"PAIEMENT", kKeywordPayment},
+    // Money-in words (AUTODEPOSIT is covered by DEPOSIT)
+    {"DEPOSIT", kKeywordCredit},
+    {"CREDIT", kKeywordCredit},
+    {"TRANSFER FROM", kKeywordCredit},
+    {"INCOMING", kKeywordCredit},
+    {"RECEIVED", kKeywordCredit},
+};
+
+uint32_t classify(const std::string& text) {
+    std::string upper = text;
+    for (char& c : upper) {
+        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    uint32_t keywords = 0;
+    for (const KeywordBit& keyword : kKeywords) {
+        if (upper.find(keyword.word) != std::string::npos) {
+            keywords |= keyword.bit;
+        }
+    }
+    return keywords;
+}
+
+} // namespace
+
+uint32_t DescriptionPool::intern(std::string_view raw) {
+    auto spelling = spellingIds_.find(raw);
+    if (spelling != spellingIds_.end()) {
+        return spelling->second;
+    }
+
+    std::string cleaned = cleanDescription(raw);
+    uint32_t id;
+    auto found = textIds_.find(cleaned);
+    if (found != textIds_.end()) {
+        id = found->second;
+    } else {
+        id = static_cast<uint32_t>(entries_.size());
+        uint32_t keywords = classify(cleaned);
+        entries_.push_back({std::move(cleaned), keywords});
+        textIds_.emplace(entries_.back().text, id);
+    }
+
+    // Remember this spelling; most are already clean and share the entry's text
+    const std::string& text = entries_[id].text;
+    if (raw == text) {
+        spellingIds_.emplace(text, id);
+    } else {
+        spellings_.emplace_back(raw);
+        spellingIds_.emplace(spellings_.back(), id);
+    }
+    return id;
+}
+
+} // namespace BankAnalyzer
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace BankAnalyzer {
+
+// Words the patterns' header and direction checks look for, as bits of
+// DescriptionPool::keywords(). Matched anywhere, ignoring case.
+constexpr uint32_t kKeywordDescription = 1u << 0;
+constexpr uint32_t kKeywordWithdrawal = 1u << 1;
+constexpr uint32_t kKeywordDeposit = 1u << 2;
+constexpr uint32_t kKeywordBalance = 1u << 3;
+constexpr uint32_t kKeywordDate = 1u << 4;
+constexpr uint32_t kKeywordOpening = 1u << 5;
+constexpr uint32_t kKeywordClosing = 1u << 6;
+constexpr uint32_t kKeywordTotal = 1u << 7;
+constexpr uint32_t kKeywordSummary = 1u << 8;
+constexpr uint32_t kKeywordAccountDetails = 1u << 9;   // "DETAILS OF YOUR ACCOUNT"
+constexpr uint32_t kKeywordTrans = 1u << 10;
+constexpr uint32_t kKeywordPost = 1u << 11;
+constexpr uint32_t kKeywordAmount = 1u << 12;
+constexpr uint32_t kKeywordPayment = 1u << 13;         // "PAYMENT" or "PAIEMENT"
+constexpr uint32_t kKeywordCredit = 1u << 14;          // Money coming in (balance_reconciliation.h)
+
+/**
+ * The distinct descriptions of one pattern run, each cleaned and classified
+ * once.
+ *
+ * Statements repeat the same few descriptions ("E-TRANSFER SENT", the
+ * payroll line, the coffee shop) on row after row. intern() maps a raw
+ * description slice to the id of its cleaned form (cleanDescription), so
+ * every later row with that spelling costs one hash lookup instead of a
+ * clean, an upper-case copy and a dozen substring searches. Spellings that
+ * clean to the same text share an id.
+ *
+ * Lives in the pattern run's scratch memory (scratch_arena.h): drop the pool
+ * before the arena rewinds.
+ */
+class DescriptionPool {
+public:
+    /**
+     * Id of raw's cleaned form, added on first sight
+     */
+    uint32_t intern(std::string_view raw);
+
+    const std::string& text(uint32_t id) const { return entries_[id].text; }
+    uint32_t keywords(uint32_t id) const { return entries_[id].keywords; }
+
+    // Whether the description has any / all of the kKeyword* bits in mask
+    bool hasAny(uint32_t id, uint32_t mask) const { return (keywords(id) & mask) != 0; }
+    bool hasAll(uint32_t id, uint32_t mask) const { return (keywords(id) & mask) == mask; }
+
+    size_t size() const { return entries_.size(); }
+
+private:
+    struct Entry {
+        std::string text;
+        uint32_t keywords;
+    };
+
+    // Deques so the map keys (views of these strings) never move
+    std::deque<Entry> entries_;
+    std::deque<std::string> spellings_;    // Raw slices that clean to something else
+    std::unordered_map<std::string_view, uint32_t> textIds_;
+    std::unordered_map<std::string_view, uint32_t> spellingIds_;
+};
+
+} // namespace BankAnalyzer
@@ -0,0 +1,496 @@
+// Extended pattern pack: Patterns 10, 4, 6, 5, 7, 8 and 9, the rarer layouts
+// (check registers, exports, reference numbers, brokerage, bilingual and
+// multi-currency statements). These still use std::regex, so they live in
+// their own library and, in the browser, their own WASM module that is only
+// fetched when the base pack finds nothing.
+
+#include "transaction_extractor.h"
+#include "pattern_pack.h"
+#include <regex>
+
+namespace BankAnalyzer {
+
+using BudgetedMatch = std::match_results<BudgetedIterator>;
+
+namespace {
+
+// segmentRecords() never cuts a window the searches below would refuse
+static_assert(kMaxRecordBytes <= kMaxRegexInput, "record windows must fit a regex search");
+
+// Matches of a pattern record window by record window (see record_segmenter.h),
+// so no match runs on past the end of the record it started in. Same search
+// as std::regex_iterator within a record, but one match_results is reused
+// across records instead of a new iterator per record.
+class RecordMatchIterator {
+public:
+    RecordMatchIterator(std::string_view text, const std::regex& pattern, PatternContext& ctx)
+        : text_(text), pattern_(pattern), ctx_(ctx) {
+        search();
+    }
+
+    bool done() const { return done_; }
+
+    const BudgetedMatch& operator*() const { return match_; }
+
+    RecordMatchIterator& operator++() {
+        // No pattern here can match empty text, so the next search can start
+        // where this match ended
+        position_ = match_[0].second;
+        flags_ = std::regex_constants::match_prev_avail;
+        search();
+        return *this;
+    }
+
+private:
+    void search() {
+        for (;;) {
+            if (position_ != recordEnd_ &&
+                std::regex_search(position_, recordEnd_, match_, pattern_, flags_)) {
+                return;
+            }
+            if (record_ == ctx_.records.size()) {
+                done_ = true;
+                return;
+            }
+            const RecordWindow& record = ctx_.records[record_++];
+            if (record.end - record.begin > kMaxRegexInput) {
+                throw BudgetExceeded{false};
+            }
+            position_ = BudgetedIterator(text_.data() + record.begin, &ctx_.budget);
+            recordEnd_ = BudgetedIterator(text_.data() + record.end, &ctx_.budget);
+            flags_ = std::regex_constants::match_default;
+        }
+    }
+
+    std::string_view text_;
+    const std::regex& pattern_;
+    PatternContext& ctx_;
+    size_t record_ = 0;
+    BudgetedIterator position_;
+    BudgetedIterator recordEnd_;
+    std::regex_constants::match_flag_type flags_ = std::regex_constants::match_default;
+    BudgetedMatch match_;
+    bool done_ = false;
+};
+
+} // namespace
+
+// ============================================================================
+// PATTERN EXTRACTION FUNCTIONS
+// ============================================================================
+
+// Pattern 4: Check-Heavy Format (Wells Fargo, regional banks)
+// Format: Check # | Date | Description | Debit | Credit | Balance
+std::vector<Transaction> tryPattern4(std::string_view text, PatternContext& ctx) {
+    std::vector<Transaction> transactions;
+
+    // Pattern: (Check#) (Date) (Description) (Debit) (Credit) (Balance)
+    std::regex pattern(
+        R"((\d{3,6}|\*{4})\s+)"  // Check number or ****
+        R"((\d{1,2}[/-]\d{1,2}[/-]\d{2,4})\s+)"
+        R"((.+?)\s+)"
+        R"((?:(\d{1,3}(?:,\d{3})*\.\d{2})|\s+)\s+)"  // Debit or empty
+        R"((?:(\d{1,3}(?:,\d{3})*\.\d{2})|\s+)\s+)"  // Credit or empty
+        R"((\d{1,3}(?:,\d{3})*\.\d{2}))"              // Balance
+    );
+
+    RecordMatchIterator iter(text, pattern, ctx);
+
+    while (!iter.done()) {
+        TELLER_COUNT(ctx.stats, attempted);
+        const BudgetedMatch& match = *iter;
+
+        std::string checkNum = match[1].str();
+        std::string date = match[2].str();
+        uint32_t descriptionId = ctx.descriptions.intern(match[3].str());
+        const std::string& description = ctx.descriptions.text(descriptionId);
+        std::string debit = match[4].str();
+        std::string credit = match[5].str();
+        std::string balanceStr = match[6].str();
+
+        // Skip headers
+        if (ctx.descriptions.hasAny(descriptionId, kKeywordDescription)) {
+            TELLER_COUNT(ctx.stats, rejectedHeader);
+            ++iter;
+            continue;
+        }
+
+        // Skip if description is too short
+        if (description.length() < 3) {
+            TELLER_COUNT(ctx.stats, rejectedTooShort);
+            ++iter;
+            continue;
+        }
+
+        Transaction txn;
+        txn.date = date;
+        txn.description = description;
+
+        // Parse amount from debit or credit column
+        bool isNegative = false;
+        if (!debit.empty() && debit.find_first_of("0123456789") != std::string::npos) {
+            txn.amount = parseAmount(debit, isNegative);
+            txn.type = "debit";
+        } else if (!credit.empty() && credit.find_first_of("0123456789") != std::string::npos) {
+            txn.amount = parseAmount(credit, isNegative);
+            txn.type = "credit";
+        } else {
+            TELLER_COUNT(ctx.stats, rejectedNoAmount);
+            ++iter;
+            continue;
+        }
+
+        txn.balance = parseBalance(balanceStr);
+        txn.hasBalance = true;
+        txn.category = "uncategorized";
+
+        TELLER_COUNT(ctx.stats, accepted);
+        transactions.push_back(txn);
+        ++iter;
+    }
+
+    return transactions;
+}
+
+// Pattern 5: Minimal Export Format (CSV-like)
+// Format: Date | Description | Amount
+std::vector<Transaction> tryPattern5(std::string_view text, PatternContext& ctx) {
+    std::vector<Transaction> transactions;
+
+    // Pattern: (Date) (Description) (Amount) [no balance]
+    std::regex pattern(
+        R"((\d{1,2}[/-]\d{1,2}[/-]\d{2,4}|\d{4}-\d{2}-\d{2})\s+)"
+        R"((.+?)\s+)"
+        R"((-?[\$€£¥₹]?\s*\d{1,3}(?:,\d{3})*\.\d{2})(?:\s|$))"
+    );
+
+    RecordMatchIterator iter(text, pattern, ctx);
+
+    while (!iter.done()) {
+        TELLER_COUNT(ctx.stats, attempted);
+        const BudgetedMatch& match = *iter;
+
+        std::string date = match[1].str();
+        uint32_t descriptionId = ctx.descriptions.intern(match[2].str());
+        const std::string& description = ctx.descriptions.text(descriptionId);
+        std::string amountStr = match[3].str();
+
+        // Skip headers
+        if (ctx.descriptions.hasAny(descriptionId, kKeywordDescription)) {
+            TELLER_COUNT(ctx.stats, rejectedHeader);
+            ++iter;
+            continue;
+        }
+
+        // Skip if description is too short
+        if (description.length() < 3) {
+            TELLER_COUNT(ctx.stats, rejectedTooShort);
+            ++iter;
+            continue;
+        }
+
+        // Parse amount
+        bool isNegative = false;
+        Money amount = parseAmount(amountStr, isNegative);
+
+        Transaction txn;
+        txn.date = date;
+        txn.description = description;
+        txn.amount = amount;
+        txn.balance = Money();
+        txn.type = isNegative ? "debit" : "credit";
+        txn.category = "uncategorized";
+
+        TELLER_COUNT(ctx.stats, accepted);
+        transactions.push_back(txn);
+        ++iter;
+    }
+
+    return transactions;
+}
+
+// Pattern 6: Reference Number Format (7% coverage)
+// Format: Date | Reference | Description | Amount | Balance
+std::vector<Transaction> tryPattern6(std::string_view text, PatternContext& ctx) {
+    std::vector<Transaction> transactions;
+
+    // Pattern: (Date) (ReferenceNum) (Description) (Amount) (optional Balance)
+    std::regex pattern(
+        R"((\d{1,2}[/-]\d{1,2}[/-]\d{2,4})\s+)"
+        R"(([A-Z0-9]{6,20})\s+)"  // Reference number
+        R"((.+?)\s+)"
+        R"((-?\$?\d{1,3}(?:,\d{3})*\.\d{2})\s+)"
+        R"((\$?\d{1,3}(?:,\d{3})*\.\d{2})?(?:\s|$))"   // Balance
+    );
+
+    RecordMatchIterator iter(text, pattern, ctx);
+
+    while (!iter.done()) {
+        TELLER_COUNT(ctx.stats, attempted);
+        const BudgetedMatch& match = *iter;
+
+        std::string date = match[1].str();
+        std::string reference = match[2].str();
+        uint32_t descriptionId = ctx.descriptions.intern(match[3].str());
+        const std::string& description = ctx.descriptions.text(descriptionId);
+        std::string amountStr = match[4].str();
+        std::string balanceStr = match[5].str();
+
+        if (description.length() < 3) {
+            TELLER_COUNT(ctx.stats, rejectedTooShort);
+            ++iter;
+            continue;
+        }
+
+        bool isNegative = false;
+        Money amount = parseAmount(amountStr, isNegative);
+
+        Transaction txn;
+        txn.date = date;
+        txn.description = description;
+        txn.amount = amount;
+        txn.balance = balanceStr.empty() ? Money() : parseBalance(balanceStr);
+        txn.hasBalance = !balanceStr.empty();
+        txn.type = isNegative ? "debit" : "credit";
+        txn.category = "uncategorized";
+
+        TELLER_COUNT(ctx.stats, accepted);
+        transactions.push_back(txn);
+        ++iter;
+    }
+
+    return transactions;
+}
+
+// Pattern 7: Investment/Brokerage Format (5% coverage)
+// Format: Trade Date | Settlement Date | Symbol | Description | Type | Quantity | Price | Amount
+std::vector<Transaction> tryPattern7(std::string_view text, PatternContext& ctx) {
+    std::vector<Transaction> transactions;
+
+    // Simplified investment pattern
+    std::regex pattern(
+        R"((\d{1,2}/\d{1,2}/\d{2,4})\s+)"  // Trade date
+        R"((\d{1,2}/\d{1,2}/\d{2,4})\s+)"  // Settlement date
+        R"(([A-Z]{1,5})\s+)"                // Symbol
+        R"((.+?)\s+)"                       // Description
+        R"((BUY|SELL|DIV|INT)\s+)"         // Type
+        R"((-?\d+(?:\.\d+)?)\s+)"          // Quantity
+        R"((\d+\.\d{2,4})\s+)"             // Price
+        R"((-?\d{1,3}(?:,\d{3})*\.\d{2}))" // Amount
+    );
+
+    RecordMatchIterator iter(text, pattern, ctx);
+
+    while (!iter.done()) {
+        TELLER_COUNT(ctx.stats, attempted);
+        const BudgetedMatch& match = *iter;
+
+        std::string date = match[1].str();
+        std::string symbol = match[3].str();
+        uint32_t descriptionId = ctx.descriptions.intern(match[4].str());
+        const std::string& description = ctx.descriptions.text(descriptionId);
+        std::string amountStr = match[8].str();
+
+        bool isNegative = false;
+        Money amount = parseAmount(amountStr, isNegative);
+
+        Transaction txn;
+        txn.date = date;
+        txn.description = symbol + " " + description;
+        txn.amount = amount;
+        txn.balance = Money();
+        txn.type = isNegative ? "debit" : "credit";
+        txn.category = "uncategorized";
+
+        TELLER_COUNT(ctx.stats, accepted);
+        transactions.push_back(txn);
+        ++iter;
+    }
+
+    return transactions;
+}
+
+// Pattern 8: Bilingual English/French (3% coverage)
+// Format: Date | Description/Description | Débit/Debit | Crédit/Credit | Solde/Balance
+std::vector<Transaction> tryPattern8(std::string_view text, PatternContext& ctx) {
+    std::vector<Transaction> transactions;
+
+    // French month names support
+    std::regex pattern(
+        R"(((?:Jan|Feb|Mar|Apr|May|Jun|Jul|Aug|Sep|Oct|Nov|Dec|Janv|Févr|Mars|Avr|Mai|Juin|Juil|Août|Sept)[a-z]*\s+\d{1,2})\s+)"
+        R"((.*?)\s+)"
+        R"((?:(\d{1,3}(?:[,\s]\d{3})*[,\.]\d{2})|\s+)\s+)"  // Debit (European decimal)
+        R"((?:(\d{1,3}(?:[,\s]\d{3})*[,\.]\d{2})|\s+)\s+)"  // Credit
+        R"((\d{1,3}(?:[,\s]\d{3})*[,\.]\d{2}))"              // Balance
+    );
+
+    RecordMatchIterator iter(text, pattern, ctx);
+
+    while (!iter.done()) {
+        TELLER_COUNT(ctx.stats, attempted);
+        const BudgetedMatch& match = *iter;
+
+        std::string date = match[1].str();
+        uint32_t descriptionId = ctx.descriptions.intern(match[2].str());
+        const std::string& description = ctx.descriptions.text(descriptionId);
+        std::string debit = match[3].str();
+        std::string credit = match[4].str();
+        std::string balanceStr = match[5].str();
+
+        if (description.length() < 3) {
+            TELLER_COUNT(ctx.stats, rejectedTooShort);
+            ++iter;
+            continue;
+        }
+
+        Transaction txn;
+        txn.date = date;
+        txn.description = description;
+
+        bool isNegative = false;
+        if (!debit.empty() && debit.find_first_of("0123456789") != std::string::npos) {
+            txn.amount = parseAmount(debit, isNegative);
+            txn.type = "debit";
+        } else if (!credit.empty() && credit.find_first_of("0123456789") != std::string::npos) {
+            txn.amount = parseAmount(credit, isNegative);
+            txn.type = "credit";
+        } else {
+            TELLER_COUNT(ctx.stats, rejectedNoAmount);
+            ++iter;
+            continue;
+        }
+
+        txn.balance = parseBalance(balanceStr);
+        txn.hasBalance = true;
+        txn.category = "uncategorized";
+
+        TELLER_COUNT(ctx.stats, accepted);
+        transactions.push_back(txn);
+        ++iter;
+    }
+
+    return transactions;
+}
+
+// Pattern 9: Multi-Currency Format (2% coverage)
+// Format: Date | Description | Amount | Currency | CAD Equivalent | Balance
+std::vector<Transaction> tryPattern9(std::string_view text, PatternContext& ctx) {
+    std::vector<Transaction> transactions;
+
+    std::regex pattern(
+        R"((\d{1,2}/\d{1,2}/\d{2,4})\s+)"
+        R"((.+?)\s+)"
+        R"((-?\d{1,3}(?:,\d{3})*\.\d{2})\s+)"
+        R"(([A-Z]{3})\s+)"  // Currency code (USD, CAD, EUR, etc.)
+        R"((-?\d{1,3}(?:,\d{3})*\.\d{2}))"  // Converted amount
+    );
+
+    RecordMatchIterator iter(text, pattern, ctx);
+
+    while (!iter.done()) {
+        TELLER_COUNT(ctx.stats, attempted);
+        const BudgetedMatch& match = *iter;
+
+        std::string date = match[1].str();
+        uint32_t descriptionId = ctx.descriptions.intern(match[2].str());
+        const std::string& description = ctx.descriptions.text(descriptionId);
+        std::string amountStr = match[3].str();
+        std::string currency = match[4].str();
+
+        if (description.length() < 3) {
+            TELLER_COUNT(ctx.stats, rejectedTooShort);
+            ++iter;
+            continue;
+        }
+
+        bool isNegative = false;
+        Money amount = parseAmount(amountStr, isNegative);
+        amount.currency = currencyFromCode(currency);
+
+        Transaction txn;
+        txn.date = date;
+        txn.description = description + " (" + currency + ")";
+        txn.amount = amount;
+        txn.balance = Money();
+        txn.type = isNegative ? "debit" : "credit";
+        txn.category = "uncategorized";
+
+        TELLER_COUNT(ctx.stats, accepted);
+        transactions.push_back(txn);
+        ++iter;
+    }
+
+    return transactions;
+}
+
+// Pattern 10: Legacy/Simple Single-Date-Amount (10% coverage)
+// Format: Date | Description | Amount (very permissive, catches many edge cases)
+std::vector<Transaction> tryPattern10(std::string_view text, PatternContext& ctx) {
+    std::vector<Transaction> transactions;
+
+    // Very permissive pattern for legacy formats
+    std::regex pattern(
+        R"(((?:Jan|Feb|Mar|Apr|May|Jun|Jul|Aug|Sep|Oct|Nov|Dec)[a-z]*\s+\d{1,2}|\d{1,2}[/-]\d{1,2}(?:[/-]\d{2,4})?)\s+)"
+        R"((.{5,80}?)\s+)"  // Description (5-80 chars)
+        R"((\d{1,3}(?:,\d{3})*\.\d{2})(?:\s|$))"  // Amount (no negative, no currency)
+    );
+
+    RecordMatchIterator iter(text, pattern, ctx);
+
+    while (!iter.done()) {
+        TELLER_COUNT(ctx.stats, attempted);
+        const BudgetedMatch& match = *iter;
+
+        std::string date = match[1].str();
+        uint32_t descriptionId = ctx.descriptions.intern(match[2].str());
+        const std::string& description = ctx.descriptions.text(descriptionId);
+        std::string amountStr = match[3].str();
+
+        // Skip headers
+        if (ctx.descriptions.hasAny(descriptionId, kKeywordDescription | kKeywordBalance | kKeywordTotal)) {
+            TELLER_COUNT(ctx.stats, rejectedHeader);
+            ++iter;
+            continue;
+        }
+
+        if (description.length() < 5) {
+            TELLER_COUNT(ctx.stats, rejectedTooShort);
+            ++iter;
+            continue;
+        }
+
+        bool isNegative = false;
+        Money amount = parseAmount(amountStr, isNegative);
+
+        Transaction txn;
+        txn.date = date;
+        txn.description = description;
+        txn.amount = amount;
+        txn.balance = Money();
+        txn.type = "debit";  // Assume debit for legacy formats
+        txn.category = "uncategorized";
+
+        TELLER_COUNT(ctx.stats, accepted);
+        transactions.push_back(txn);
+        ++iter;
+    }
+
+    return transactions;
+}
+
+const PatternPack& extendedPatternPack() {
+    // Cascade order continues from the base pack
+    static const PatternDefinition patterns[] = {
+        {10, tryPattern10},  // 10% coverage - try early as fallback
+        {4,  tryPattern4},   // 8% coverage
+        {6,  tryPattern6},   // 7% coverage
+        {5,  tryPattern5},   // 5% coverage
+        {7,  tryPattern7},   // 5% coverage
+        {8,  tryPattern8},   // 3% coverage
+        {9,  tryPattern9},   // 2% coverage
+    };
+    static const PatternPack pack = {"extended", patterns, sizeof(patterns) / sizeof(patterns[0])};
+    return pack;
+}
+
+} // namespace BankAnalyzer
@@ -0,0 +1,229 @@
+#include "extraction_job.h"
+#include "pattern_pack.h"
+#include "balance_reconciliation.h"
+#include "scratch_arena.h"
+#include <algorithm>
+
+namespace BankAnalyzer {
+
+namespace {
+
+using Clock = MatchBudget::Clock;
+
+uint64_t nanosecondsSince(Clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+}
+
+} // namespace
+
+ExtractionJob::ExtractionJob(const TransactionExtractor& extractor, std::string text)
+    : text_(std::move(text)), limits_(extractor.limits()) {
+    for (const PatternPack* pack : extractor.packs_) {
+        for (size_t i = 0; i < pack->count; ++i) {
+            cascade_.push_back(&pack->patterns[i]);
+        }
+    }
+
+    ScopedMetric<ExtractorStats> metric(stats_);
+    records_ = segmentRecords(text_);
+    stats_.records = records_.size();
+    totalBytes_ = text_.size();
+    done_ = cascade_.empty();
+}
+
+ExtractionJob::~ExtractionJob() {
+}
+
+ExtractionProgress ExtractionJob::step(size_t maxBytes, double maxMilliseconds) {
+    if (done_) {
+        return progress();
+    }
+
+    Clock::time_point start = Clock::now();
+    // The deadline only counts time spent in here
+    auto remaining = std::chrono::duration<double, std::milli>(limits_.deadlineMs) -
+                     std::chrono::nanoseconds(workNanoseconds_);
+    Clock::time_point deadline = start + std::chrono::duration_cast<Clock::duration>(remaining);
+    auto stepBudget = std::chrono::duration<double, std::milli>(maxMilliseconds);
+
+    {
+        ScopedMetric<ExtractorStats> metric(stats_);
+        size_t processed = 0;
+        while (!done_) {
+            size_t sliceBytes = maxBytes == 0 ? kSliceBytes : std::min(kSliceBytes, maxBytes - processed);
+            if (maxMilliseconds > 0) {
+                // Patterns differ in speed by 50x; size the slice to what the
+                // current one can match in the time left
+                double left = std::chrono::duration<double, std::nano>(stepBudget - (Clock::now() - start)).count();
+                double fits = bytesPerNanosecond_ > 0 ? bytesPerNanosecond_ * left : 0.0;
+                sliceBytes = std::min(sliceBytes, std::max(kMinSliceBytes, static_cast<size_t>(fits)));
+            }
+
+            Clock::time_point sliceStart = Clock::now();
+            size_t pattern = patternIndex_;
+            size_t bytes = runSlice(sliceBytes, deadline);
+            uint64_t elapsed = nanosecondsSince(sliceStart);
+            if (patternIndex_ == pattern && elapsed > 0) {
+                bytesPerNanosecond_ = static_cast<double>(bytes) / static_cast<double>(elapsed);
+            }
+
+            processed += bytes;
+            if (maxBytes != 0 && processed >= maxBytes) {
+                break;
+            }
+            if (maxMilliseconds > 0 && Clock::now() - start >= stepBudget) {
+                break;
+            }
+        }
+    }
+    workNanoseconds_ += nanosecondsSince(start);
+
+    if (done_) {
+#if TELLER_METRICS
+        for (const auto& pattern : stats_.patterns) {
+            stats_.bytesScanned += pattern.bytesScanned;
+        }
+#endif
+        releaseInput();
+    }
+    return progress();
+}
+
+// Hand the current pattern the next run of record windows (at least one, at
+// most about maxBytes of text) and keep what it finds. Returns the bytes
+// handed over.
+size_t ExtractionJob::runSlice(size_t maxBytes, Clock::time_point deadline) {
+    const PatternDefinition& entry = *cascade_[patternIndex_];
+    if (nextRecord_ == records_.size()) {
+        finishPattern();
+        return 0;
+    }
+
+    size_t end = nextRecord_;
+    size_t bytes = 0;
+    do {
+        bytes += records_[end].end - records_[end].begin;
+        ++end;
+    } while (end < records_.size() && bytes + (records_[end].end - records_[end].begin) <= maxBytes);
+    std::vector<RecordWindow> slice(records_.begin() + nextRecord_, records_.begin() + end);
+
+    // One budget for the pattern's whole pass, as in extract()
+    if (!budget_) {
+        budget_ = std::make_unique<MatchBudget>(limits_.baseSteps + limits_.stepsPerByte * text_.size(),
+                                                deadline, limits_.deadlineMs > 0);
+    }
+    budget_->setDeadline(deadline);
+
+    PatternStats& patternStats = stats_.pattern(entry.id);
+#if TELLER_METRICS
+    patternStats.bytesScanned += bytes;
+#endif
+    uint64_t stepsBefore = budget_->steps();
+    bool aborted = false;
+    bool deadlineExceeded = false;
+    {
+        ScopedMetric<PatternStats> metric(patternStats);
+        // Row strings and regex state live in the scratch arena for the
+        // slice; the rows are copied to the heap before the next one opens it
+        ScratchScope scratch;
+        std::string lastDate = lastDate_;
+        DescriptionPool descriptions;   // Per slice: it lives in the slice's scratch
+        PatternContext ctx{patternStats, *budget_, slice, lastDate, descriptions};
+        std::vector<Transaction> found;
+        try {
+            budget_->checkDeadline();
+            found = entry.run(text_, ctx);
+            markCreditKeywords(found, descriptions);
+        } catch (const BudgetExceeded& exceeded) {
+            aborted = true;
+            deadlineExceeded = exceeded.deadline;
+        }
+        scratch.release();
+        transactions_.insert(transactions_.end(), found.begin(), found.end());
+        lastDate_ = lastDate;
+
+        stats_.scratchBytes = std::max<uint64_t>(stats_.scratchBytes, scratch.arena().peak());
+        stats_.scratchOverflows += scratch.arena().overflowAllocations();
+    }
+    patternStats.steps += budget_->steps() - stepsBefore;
+
+    if (aborted) {
+        // Abandoned with no partial results, as in extract()
+        patternStats.aborted = true;
+        std::vector<Transaction>().swap(transactions_);
+        if (deadlineExceeded) {
+            stats_.deadlineExceeded = true;
+            done_ = true;
+        } else {
+            nextPattern();
+        }
+        return bytes;
+    }
+
+    nextRecord_ = end;
+    if (nextRecord_ == records_.size()) {
+        finishPattern();
+    }
+    return bytes;
+}
+
+// The current pattern has seen every record: first one with results wins
+void ExtractionJob::finishPattern() {
+    if (transactions_.empty()) {
+        nextPattern();
+        return;
+    }
+    reconcileBalances(transactions_, stats_.balance);
+    stats_.matchedPattern = cascade_[patternIndex_]->id;
+    done_ = true;
+}
+
+void ExtractionJob::nextPattern() {
+    ++patternIndex_;
+    nextRecord_ = 0;
+    budget_.reset();
+    lastDate_.clear();
+    bytesPerNanosecond_ = 0.0;
+    done_ = patternIndex_ == cascade_.size();
+}
+
+void ExtractionJob::cancel() {
+    cancelled_ = true;
+    done_ = true;
+    releaseInput();
+    std::vector<Transaction>().swap(transactions_);
+}
+
+void ExtractionJob::releaseInput() {
+    std::string().swap(text_);
+    std::vector<RecordWindow>().swap(records_);
+    nextRecord_ = 0;
+    budget_.reset();
+}
+
+ExtractionProgress ExtractionJob::progress() const {
+    ExtractionProgress progress;
+    progress.totalBytes = totalBytes_;
+    if (done_) {
+        progress.bytesProcessed = cancelled_ ? 0 : totalBytes_;
+        progress.pattern = stats_.matchedPattern;
+    } else {
+        progress.bytesProcessed = nextRecord_ > 0 ? records_[nextRecord_ - 1].end : 0;
+        progress.pattern = cascade_[patternIndex_]->id;
+    }
+    progress.transactions = transactions_.size();
+    progress.patternsTried = patternIndex_;
+    progress.patternCount = cascade_.size();
+    progress.done = done_;
+    progress.cancelled = cancelled_;
+    return progress;
+}
+
+std::vector<Transaction> ExtractionJob::takeTransactions() {
+    if (!done_ || cancelled_) {
+        return {};
+    }
+    return std::move(transactions_);
+}
+
+} // namespace BankAnalyzer
@@ -0,0 +1,119 @@
+#pragma once
+#include "transaction_extractor.h"
+#include "record_segmenter.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace BankAnalyzer {
+
+/**
+ * Where a job stands after a step
+ */
+struct ExtractionProgress {
+    size_t bytesProcessed = 0;      // Of the current pattern's pass over the text
+    size_t totalBytes = 0;
+    size_t transactions = 0;        // Rows the current pattern has found so far
+    int pattern = 0;                // Pattern running (once done, the one that matched or 0)
+    size_t patternsTried = 0;       // Patterns of the cascade finished before this one
+    size_t patternCount = 0;
+    bool done = false;
+    bool cancelled = false;
+};
+
+/**
+ * An extract() that runs a slice at a time, so a UI thread can interleave
+ * it with rendering, show progress and drop a statement it no longer wants.
+ *
+ * The same cascade as TransactionExtractor::extract(), with the same result:
+ * every pattern matches one record window at a time (record_segmenter.h),
+ * so a pattern run over consecutive runs of windows finds the rows it would
+ * have found in one pass. Each step() hands the current pattern windows until
+ * its byte or time budget is spent, then returns.
+ *
+ * Limits work as in extract(), except that the deadline counts only the time
+ * spent inside step(); time the caller spends between steps is its own.
+ * Stats accumulate over the steps like one extract() call.
+ */
+class ExtractionJob {
+public:
+    /**
+     * Copies the extractor's pattern cascade and limits; the extractor
+     * itself isn't referenced afterwards
+     * @param text Text extracted from PDF (owned by the job)
+     */
+    ExtractionJob(const TransactionExtractor& extractor, std::string text);
+    ~ExtractionJob();
+
+    ExtractionJob(const ExtractionJob&) = delete;
+    ExtractionJob& operator=(const ExtractionJob&) = delete;
+
+    /**
+     * Run until about maxBytes of record text have been matched or
+     * maxMilliseconds have passed, whichever comes first (0 = no limit on
+     * that; both 0 runs to the end). Budgets are checked between slices of
+     * at most kSliceBytes; with a time limit, slices are sized from the
+     * current pattern's measured speed so a step ends close to the limit.
+     * A step always makes progress, at least one record window (at most
+     * kMaxRecordBytes).
+     */
+    ExtractionProgress step(size_t maxBytes, double maxMilliseconds = 0.0);
+
+    /**
+     * Stop for good and free the text and partial results. Later steps
+     * return at once with cancelled set. (A job that finishes frees the
+     * text by itself and keeps only the result and stats.)
+     */
+    void cancel();
+
+    ExtractionProgress progress() const;
+    bool done() const { return done_; }
+
+    /**
+     * The result, once done (empty if cancelled). Moves it out of the job.
+     */
+    std::vector<Transaction> takeTransactions();
+
+    /**
+     * Metrics for the steps so far, in the shape extract() leaves them
+     */
+    const ExtractorStats& stats() const { return stats_; }
+
+    /**
+     * Upper bound on the record text one slice hands a pattern. Every
+     * slice pays the pattern's setup (the extended pack compiles its
+     * std::regex per call), so slices much smaller than this cost throughput.
+     */
+    static constexpr size_t kSliceBytes = 64u << 10;
+
+    /**
+     * Smallest slice a time-limited step hands out (the first one of each
+     * pattern, which measures its speed)
+     */
+    static constexpr size_t kMinSliceBytes = 4u << 10;
+
+private:
+    size_t runSlice(size_t maxBytes, MatchBudget::Clock::time_point deadline);
+    void finishPattern();
+    void nextPattern();
+    void releaseInput();
+
+    std::string text_;
+    size_t totalBytes_ = 0;
+    std::vector<RecordWindow> records_;
+    std::vector<const PatternDefinition*> cascade_;
+    ExtractionLimits limits_;
+    ExtractorStats stats_;
+
+    size_t patternIndex_ = 0;       // Into cascade_
+    size_t nextRecord_ = 0;         // First record the current pattern hasn't seen
+    std::unique_ptr<MatchBudget> budget_;   // Current pattern's, carried across slices
+    std::vector<Transaction> transactions_; // Current pattern's rows so far
+    std::string lastDate_;          // Current pattern's date carry-forward (PatternContext)
+    uint64_t workNanoseconds_ = 0;  // Time spent inside step(), for the deadline
+    double bytesPerNanosecond_ = 0.0;   // Current pattern's speed over its last slice
+    bool done_ = false;
+    bool cancelled_ = false;
+};
+
+} // namespace BankAnalyzer
@@ -0,0 +1,67 @@
+#include "extractor_stats.h"
+#include "scratch_arena.h"
+#include <cstdlib>
+#include <new>
+
+namespace BankAnalyzer {
+
+#if TELLER_METRICS
+
+namespace {
+thread_local uint64_t allocationCount = 0;
+}
+
+uint64_t threadAllocationCount() {
+    return allocationCount;
+}
+
+#else
+
+uint64_t threadAllocationCount() {
+    return 0;
+}
+
+#endif
+
+} // namespace BankAnalyzer
+
+#if TELLER_METRICS || TELLER_SCRATCH_ARENA
+
+// Replacement global allocation functions. Counting is one thread-local
+// increment; inside a ScratchScope the block comes from the thread's scratch
+// arena (see scratch_arena.h). The array, nothrow and sized forms forward to
+// these by default.
+void* operator new(std::size_t size) {
+#if TELLER_METRICS
+    ++BankAnalyzer::allocationCount;
+#endif
+#if TELLER_SCRATCH_ARENA
+    if (void* p = BankAnalyzer::scratchAllocate(size)) {
+        return p;
+    }
+#endif
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+#if TELLER_SCRATCH_ARENA
+    if (BankAnalyzer::scratchRelease(p)) {
+        return;     // Reclaimed when the arena is rewound
+    }
+#endif
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t size) noexcept {
+#if TELLER_SCRATCH_ARENA
+    if (BankAnalyzer::scratchRelease(p, size)) {
+        return;     // Reclaimed now if it was the last block, else on rewind
+    }
+#endif
+    std::free(p);
+}
+
+#endif
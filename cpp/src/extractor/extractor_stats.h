@@ -0,0 +1,126 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+// Compile-time switch for the extractor metrics layer.
+// Build with -DTELLER_METRICS=OFF (CMake) to compile all counting and timing
+// out of the hot path; the stats structs stay so callers don't need #ifdefs.
+#ifndef TELLER_METRICS
+#define TELLER_METRICS 1
+#endif
+
+#if TELLER_METRICS
+#define TELLER_COUNT(stats, field) (++(stats).field)
+#else
+#define TELLER_COUNT(stats, field) ((void)0)
+#endif
+
+namespace BankAnalyzer {
+
+/**
+ * Counters for one pattern over one extraction call
+ */
+struct PatternStats {
+    uint64_t nanoseconds = 0;       // Time spent inside the pattern
+    uint64_t bytesScanned = 0;      // Input bytes handed to the pattern
+    uint64_t allocations = 0;       // Heap allocations made while it ran
+    uint64_t attempted = 0;         // Regex matches examined
+    uint64_t accepted = 0;          // Matches that became transactions
+    uint64_t rejectedHeader = 0;    // Header, total or summary rows
+    uint64_t rejectedTooShort = 0;  // Description too short or only digits
+    uint64_t rejectedNoDate = 0;    // Undated row before any date was seen
+    uint64_t rejectedNoAmount = 0;  // All amount columns empty or zero
+
+    // Budget accounting (always recorded, independent of TELLER_METRICS)
+    uint64_t steps = 0;             // Characters read by the regex engine
+    bool aborted = false;           // Budget or deadline exhausted, or a record too long for the regex; results discarded
+};
+
+/**
+ * Outcome of the running-balance pass over the winning pattern's rows
+ * (always recorded, see balance_reconciliation.h)
+ */
+struct BalanceStats {
+    uint64_t rows = 0;              // Rows carrying a statement balance
+    uint64_t inferred = 0;          // Rows whose direction came from a balance delta
+    uint64_t corrected = 0;         // ...where that overrode the column, sign or keyword guess
+    uint64_t mismatches = 0;        // Balances that don't follow from the previous one
+    uint64_t keywordFallbacks = 0;  // Rows classified by description keywords
+    bool newestFirst = false;       // Statement lists the latest transaction first
+};
+
+/**
+ * Where an extract() call spent its time.
+ * Patterns are indexed by pattern number - 1 (see PATTERNS.md).
+ */
+struct ExtractorStats {
+    static constexpr int kPatternCount = 10;
+
+    PatternStats patterns[kPatternCount];
+    int matchedPattern = 0;         // Pattern that produced the result (0 = none); always recorded
+    bool deadlineExceeded = false;  // Document deadline hit; later patterns were not tried
+    uint64_t nanoseconds = 0;       // Whole call, all patterns tried
+    uint64_t bytesScanned = 0;
+    uint64_t allocations = 0;
+    uint64_t records = 0;           // Record windows the text was cut into (always recorded, see record_segmenter.h)
+
+    // Scratch arena use (always recorded, see scratch_arena.h)
+    uint64_t scratchBytes = 0;      // Arena bytes the call used
+    uint64_t scratchOverflows = 0;  // Allocations past the arena cap that went to the heap
+
+    BalanceStats balance;
+
+    PatternStats& pattern(int id) { return patterns[id - 1]; }
+    const PatternStats& pattern(int id) const { return patterns[id - 1]; }
+
+    bool anyAborted() const {
+        for (const auto& p : patterns) {
+            if (p.aborted) return true;
+        }
+        return false;
+    }
+
+    void reset() { *this = ExtractorStats(); }
+};
+
+/**
+ * Heap allocations made by the calling thread so far.
+ * Counted by the replacement operator new in extractor_stats.cpp; always 0
+ * when TELLER_METRICS is off.
+ */
+uint64_t threadAllocationCount();
+
+/**
+ * Adds elapsed time and allocations to a stats block when it goes out of scope
+ */
+template <typename Stats>
+class ScopedMetric {
+public:
+    explicit ScopedMetric(Stats& stats) : stats_(stats) {
+#if TELLER_METRICS
+        allocationsAtStart_ = threadAllocationCount();
+        start_ = std::chrono::steady_clock::now();
+#endif
+    }
+
+    ~ScopedMetric() {
+#if TELLER_METRICS
+        auto elapsed = std::chrono::steady_clock::now() - start_;
+        stats_.nanoseconds += static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        stats_.allocations += threadAllocationCount() - allocationsAtStart_;
+#endif
+    }
+
+    ScopedMetric(const ScopedMetric&) = delete;
+    ScopedMetric& operator=(const ScopedMetric&) = delete;
+
+private:
+    Stats& stats_;
+#if TELLER_METRICS
+    std::chrono::steady_clock::time_point start_;
+    uint64_t allocationsAtStart_ = 0;
+#endif
+};
+
+} // namespace BankAnalyzer
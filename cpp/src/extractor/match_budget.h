@@ -0,0 +1,140 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+namespace BankAnalyzer {
+
+/**
+ * Limits that keep extraction latency bounded on pathological input.
+ * std::regex backtracks, and the lazy description groups can go quadratic on
+ * long newline-free text (disclaimers, number tables). Every character the
+ * regex engine reads (or position a hand-written scanner tries) is charged to
+ * a per-pattern budget; a pattern that runs out is abandoned and the cascade
+ * moves on to the next one.
+ */
+struct ExtractionLimits {
+    // Per-pattern budget = baseSteps + stepsPerByte * text size. A pattern that
+    // fits a statement reads under ~16 characters per input byte (teller-bench
+    // --unbounded); runaway ones read hundreds to thousands.
+    uint64_t baseSteps = 1000000;
+    uint64_t stepsPerByte = 64;
+
+    // Whole-document deadline across all patterns (0 = none)
+    double deadlineMs = 5000.0;
+};
+
+// Stack a regex search may assume it has: 1 MB, the WASM stack size set in
+// CMakeLists.txt. Native threads get at least 512 KB by default, which the
+// ceiling below still leaves well clear of.
+constexpr size_t kRegexStackBytes = 1u << 20;
+
+/**
+ * Longest text one std::regex search is given.
+ * The regex executors recurse per character, so a long search can overflow
+ * the stack before the step budget or the deadline gets a chance to stop it.
+ * About 200 bytes of stack per character were measured (libstdc++, -O2); a
+ * ceiling of one character per KB of stack leaves room for debug builds and
+ * other standard libraries. A longer search is treated as budget exhausted.
+ */
+constexpr size_t kMaxRegexInput = kRegexStackBytes / 1024;
+
+/**
+ * Thrown out of the regex engine when a pattern exhausts its budget
+ */
+struct BudgetExceeded {
+    bool deadline;      // true if the document deadline passed, false for the step budget
+};
+
+/**
+ * Step counter shared by all iterators of one pattern run
+ */
+class MatchBudget {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    MatchBudget(uint64_t stepLimit, Clock::time_point deadline, bool hasDeadline)
+        : stepLimit_(stepLimit), deadline_(deadline), hasDeadline_(hasDeadline) {}
+
+    void charge() {
+        ++steps_;
+        if (steps_ > stepLimit_) {
+            throw BudgetExceeded{false};
+        }
+        // Reading the clock per character would cost more than the matching
+        if ((steps_ & kClockInterval) == 0) {
+            checkDeadline();
+        }
+    }
+
+    // Bulk form for the hand-written scanners
+    void charge(uint64_t count) {
+        uint64_t before = steps_;
+        steps_ += count;
+        if (steps_ > stepLimit_) {
+            throw BudgetExceeded{false};
+        }
+        if ((before | kClockInterval) < steps_) {
+            checkDeadline();
+        }
+    }
+
+    void checkDeadline() const {
+        if (hasDeadline_ && Clock::now() > deadline_) {
+            throw BudgetExceeded{true};
+        }
+    }
+
+    uint64_t steps() const { return steps_; }
+
+    // Move the deadline (ExtractionJob resumes a pattern in a later step)
+    void setDeadline(Clock::time_point deadline) { deadline_ = deadline; }
+
+private:
+    static constexpr uint64_t kClockInterval = 0x3FFF;
+
+    uint64_t steps_ = 0;
+    uint64_t stepLimit_;
+    Clock::time_point deadline_;
+    bool hasDeadline_;
+};
+
+/**
+ * Bidirectional iterator over the input text that charges a MatchBudget on
+ * every dereference. Drop-in for const char* in std::regex_iterator (see
+ * extended_patterns.cpp; kept out of here so the base patterns don't pull in
+ * <regex>).
+ */
+class BudgetedIterator {
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = char;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const char*;
+    using reference = const char&;
+
+    BudgetedIterator() = default;
+    BudgetedIterator(const char* position, MatchBudget* budget) : position_(position), budget_(budget) {}
+
+    reference operator*() const {
+        budget_->charge();
+        return *position_;
+    }
+
+    BudgetedIterator& operator++() { ++position_; return *this; }
+    BudgetedIterator operator++(int) { BudgetedIterator old = *this; ++position_; return old; }
+    BudgetedIterator& operator--() { --position_; return *this; }
+    BudgetedIterator operator--(int) { BudgetedIterator old = *this; --position_; return old; }
+
+    bool operator==(const BudgetedIterator& other) const { return position_ == other.position_; }
+    bool operator!=(const BudgetedIterator& other) const { return position_ != other.position_; }
+
+    const char* base() const { return position_; }
+
+private:
+    const char* position_ = nullptr;
+    MatchBudget* budget_ = nullptr;
+};
+
+} // namespace BankAnalyzer
@@ -0,0 +1,56 @@
+#include "money.h"
+#include <cmath>
+#include <cstdio>
+
+namespace BankAnalyzer {
+
+CurrencyCode currencyFromCode(std::string_view code) {
+    if (code.size() != 3) {
+        return kNoCurrency;
+    }
+    CurrencyCode packed = 0;
+    for (char c : code) {
+        if (c < 'A' || c > 'Z') {
+            return kNoCurrency;
+        }
+        packed = (packed << 8) | static_cast<unsigned char>(c);
+    }
+    return packed;
+}
+
+std::string currencyName(CurrencyCode currency) {
+    if (currency == kNoCurrency) {
+        return std::string();
+    }
+    char code[3] = {
+        static_cast<char>((currency >> 16) & 0xFF),
+        static_cast<char>((currency >> 8) & 0xFF),
+        static_cast<char>(currency & 0xFF),
+    };
+    return std::string(code, 3);
+}
+
+Money Money::fromUnits(double units, CurrencyCode code) {
+    if (!std::isfinite(units)) {
+        return Money(0, code);
+    }
+    return Money(std::llround(units * kMinorPerUnit), code);
+}
+
+Money Money::dividedBy(int64_t count) const {
+    int64_t half = count / 2;
+    int64_t rounded = minor >= 0 ? (minor + half) / count : (minor - half) / count;
+    return Money(rounded, currency);
+}
+
+std::string formatMoney(Money amount) {
+    uint64_t magnitude = amount.minor < 0 ? 0 - static_cast<uint64_t>(amount.minor)
+                                          : static_cast<uint64_t>(amount.minor);
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%s%llu.%02llu", amount.minor < 0 ? "-" : "",
+                               static_cast<unsigned long long>(magnitude / Money::kMinorPerUnit),
+                               static_cast<unsigned long long>(magnitude % Money::kMinorPerUnit));
+    return std::string(buffer, static_cast<size_t>(length));
+}
+
+} // namespace BankAnalyzer
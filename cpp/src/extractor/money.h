@@ -0,0 +1,84 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace BankAnalyzer {
+
+/**
+ * ISO 4217 code packed into an integer ("GBP" is 'G' << 16 | 'B' << 8 | 'P'),
+ * or kNoCurrency when the statement doesn't say. Most don't, and a bare "$"
+ * could be USD or CAD.
+ */
+using CurrencyCode = uint32_t;
+constexpr CurrencyCode kNoCurrency = 0;
+
+/**
+ * Pack a three-letter upper-case code; anything else gives kNoCurrency
+ */
+CurrencyCode currencyFromCode(std::string_view code);
+
+/**
+ * The three-letter code, or "" for kNoCurrency
+ */
+std::string currencyName(CurrencyCode currency);
+
+/**
+ * Fixed-point amount: a count of minor units (hundredths; every amount the
+ * patterns accept has exactly two decimals) plus a currency tag.
+ *
+ * Sums are integer adds, so totals are exact to the cent however many rows
+ * go into them. Arithmetic and comparisons look at the amount only and keep
+ * the left operand's currency: amounts added together are assumed to share
+ * one, and whoever builds a total decides its tag.
+ */
+struct Money {
+    static constexpr int64_t kMinorPerUnit = 100;
+
+    int64_t minor = 0;
+    CurrencyCode currency = kNoCurrency;
+
+    Money() = default;
+    constexpr explicit Money(int64_t minorUnits, CurrencyCode code = kNoCurrency)
+        : minor(minorUnits), currency(code) {}
+
+    /**
+     * Nearest minor unit to an amount in currency units (numbers coming back
+     * from JavaScript)
+     */
+    static Money fromUnits(double units, CurrencyCode code = kNoCurrency);
+
+    /**
+     * The amount in currency units, for JavaScript and charts. Same double
+     * std::stod gives for the printed amount.
+     */
+    double toUnits() const { return static_cast<double>(minor) / kMinorPerUnit; }
+
+    /**
+     * Divide, rounding half away from zero (averages); count must be positive
+     */
+    Money dividedBy(int64_t count) const;
+
+    Money abs() const { return Money(minor < 0 ? -minor : minor, currency); }
+    Money operator-() const { return Money(-minor, currency); }
+
+    Money& operator+=(Money other) { minor += other.minor; return *this; }
+    Money& operator-=(Money other) { minor -= other.minor; return *this; }
+    friend Money operator+(Money a, Money b) { return a += b; }
+    friend Money operator-(Money a, Money b) { return a -= b; }
+
+    friend bool operator==(Money a, Money b) { return a.minor == b.minor; }
+    friend bool operator!=(Money a, Money b) { return a.minor != b.minor; }
+    friend bool operator<(Money a, Money b) { return a.minor < b.minor; }
+    friend bool operator>(Money a, Money b) { return a.minor > b.minor; }
+    friend bool operator<=(Money a, Money b) { return a.minor <= b.minor; }
+    friend bool operator>=(Money a, Money b) { return a.minor >= b.minor; }
+};
+
+/**
+ * Exact decimal text with two places and no grouping or symbol
+ * ("1234.56", "-0.05")
+ */
+std::string formatMoney(Money amount);
+
+} // namespace BankAnalyzer
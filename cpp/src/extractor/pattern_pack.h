@@ -0,0 +1,106 @@
+#pragma once
+#include "description_pool.h"
+#include "extractor_stats.h"
+#include "match_budget.h"
+#include "money.h"
+#include "record_segmenter.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace BankAnalyzer {
+
+struct Transaction;
+
+/**
+ * Per-run state handed to every pattern.
+ * Patterns match inside one record window at a time (see record_segmenter.h);
+ * the windows are cut once per document and shared by the whole cascade.
+ */
+struct PatternContext {
+    PatternStats& stats;
+    MatchBudget& budget;
+    const std::vector<RecordWindow>& records;
+    std::string& lastDate;      // Pattern 1's date carry-forward; outlives a call when ExtractionJob slices the records
+    DescriptionPool& descriptions;  // Every description the run has cleaned and classified
+};
+
+using PatternFunction = std::vector<Transaction> (*)(std::string_view text, PatternContext& ctx);
+
+struct PatternDefinition {
+    int id;                         // Pattern number (see PATTERNS.md)
+    PatternFunction run;
+};
+
+/**
+ * A group of patterns the extractor tries in order.
+ * The base pack is always linked; the extended pack lives in its own library
+ * (extractor_extended) so the base WASM module can ship without std::regex.
+ */
+struct PatternPack {
+    const char* name;
+    const PatternDefinition* patterns;
+    size_t count;
+};
+
+/**
+ * Patterns 2, 1 and 3 (the most common layouts) as hand-written scanners.
+ * No std::regex, so this pack is cheap to download and compile.
+ */
+const PatternPack& basePatternPack();
+
+/**
+ * One match of a base-pack scanner: the whole match and the capture groups of
+ * the regex it replaced, as [begin, end) offsets into the record
+ * (std::string_view::npos for a group that took no part).
+ */
+struct ScannerMatch {
+    size_t begin = 0;
+    size_t end = 0;
+    std::vector<std::pair<size_t, size_t>> groups;
+};
+
+/**
+ * Every match Pattern 1, 2 or 3 (id) finds in one record window, left to
+ * right and before any row is filtered. Lets the scanners be checked against
+ * the original regexes (PATTERNS.md).
+ */
+std::vector<ScannerMatch> scanBasePattern(int id, std::string_view record, MatchBudget& budget);
+
+/**
+ * Patterns 10, 4, 6, 5, 7, 8 and 9 (std::regex).
+ * Defined in extractor_extended; the browser loads it as a separate module
+ * only when the base pack finds nothing.
+ */
+const PatternPack& extendedPatternPack();
+
+// Helpers shared by all pattern implementations (pattern_support.cpp)
+
+/**
+ * Parse an amount column ("$1,234.56", "(12.00)", "-5.00") straight to minor
+ * units, without going through floating point. A currency symbol other than
+ * "$" sets the currency tag.
+ * @param isNegative Set when the amount has a minus sign or parentheses
+ * @return The magnitude
+ */
+Money parseAmount(const std::string& amountStr, bool& isNegative);
+
+/**
+ * Parse a balance column. Unlike amounts, an overdrawn balance keeps its sign.
+ */
+Money parseBalance(const std::string& balanceStr);
+
+/**
+ * Trim the description and collapse whitespace runs to single spaces.
+ * Patterns get it through DescriptionPool::intern(), once per spelling.
+ */
+std::string cleanDescription(std::string_view desc);
+
+/**
+ * True if text is only a number (optionally with a decimal part), e.g. "42" or "3.50"
+ */
+bool isNumericText(std::string_view text);
+
+} // namespace BankAnalyzer
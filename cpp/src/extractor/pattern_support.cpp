@@ -0,0 +1,139 @@
+#include "pattern_pack.h"
+#include "text_scan.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace BankAnalyzer {
+
+namespace {
+
+// Currency named by the symbol in an amount column. "$" alone says nothing
+// (USD, CAD, AUD, ...).
+CurrencyCode currencyFromSymbol(const std::string& amountStr) {
+    if (amountStr.find("€") != std::string::npos) return currencyFromCode("EUR");
+    if (amountStr.find("£") != std::string::npos) return currencyFromCode("GBP");
+    if (amountStr.find("¥") != std::string::npos) return currencyFromCode("JPY");
+    if (amountStr.find("₹") != std::string::npos) return currencyFromCode("INR");
+    return kNoCurrency;
+}
+
+// Leading decimal number ("1234.56", "12.5", ".75", after any whitespace) in
+// hundredths, read the way std::stod would read it but exactly; digits past
+// the second decimal round half up. Absurdly long numbers saturate at 10^15 - 1 units.
+int64_t parseMinorUnits(std::string_view text) {
+    constexpr int64_t kMaxUnits = 999999999999999;
+    size_t i = skipSpaces(text, 0);
+    if (i < text.size() && text[i] == '+') ++i;
+
+    bool digits = false;
+    int64_t units = 0;
+    for (; i < text.size() && isDigitChar(text[i]); ++i) {
+        digits = true;
+        units = std::min<int64_t>(units * 10 + (text[i] - '0'), kMaxUnits);
+    }
+
+    int64_t fraction = 0;
+    int places = 0;
+    bool roundUp = false;
+    if (i < text.size() && text[i] == '.') {
+        for (++i; i < text.size() && isDigitChar(text[i]); ++i, ++places) {
+            digits = true;
+            if (places < 2) {
+                fraction = fraction * 10 + (text[i] - '0');
+            } else if (places == 2) {
+                roundUp = text[i] >= '5';
+            }
+        }
+    }
+    if (!digits) {
+        return 0;
+    }
+    for (; places < 2; ++places) {
+        fraction *= 10;
+    }
+    return units * Money::kMinorPerUnit + fraction + (roundUp ? 1 : 0);
+}
+
+} // namespace
+
+// Helper function to clean and parse amount strings
+Money parseAmount(const std::string& amountStr, bool& isNegative) {
+    std::string cleaned = amountStr;
+
+    // Remove common currency symbols
+    const std::string currencySymbols = "$£€¥₹";
+    for (char c : currencySymbols) {
+        cleaned.erase(std::remove(cleaned.begin(), cleaned.end(), c), cleaned.end());
+    }
+
+    // Remove thousand separators (commas, spaces)
+    cleaned.erase(std::remove(cleaned.begin(), cleaned.end(), ','), cleaned.end());
+    cleaned.erase(std::remove(cleaned.begin(), cleaned.end(), ' '), cleaned.end());
+
+    // Check for negative sign or parentheses (accounting format)
+    isNegative = (cleaned.find('-') != std::string::npos) ||
+                 (amountStr.find('(') != std::string::npos);
+
+    // Remove negative signs and parentheses
+    cleaned.erase(std::remove(cleaned.begin(), cleaned.end(), '-'), cleaned.end());
+    cleaned.erase(std::remove(cleaned.begin(), cleaned.end(), '('), cleaned.end());
+    cleaned.erase(std::remove(cleaned.begin(), cleaned.end(), ')'), cleaned.end());
+
+    // Trim whitespace
+    cleaned.erase(0, cleaned.find_first_not_of(" \t\r\n"));
+    cleaned.erase(cleaned.find_last_not_of(" \t\r\n") + 1);
+
+    return Money(parseMinorUnits(cleaned), currencyFromSymbol(amountStr));
+}
+
+Money parseBalance(const std::string& balanceStr) {
+    bool isNegative = false;
+    Money balance = parseAmount(balanceStr, isNegative);
+    return isNegative ? -balance : balance;
+}
+
+// Helper function to clean description text
+std::string cleanDescription(std::string_view desc) {
+    // Trim whitespace
+    size_t first = desc.find_first_not_of(" \t\r\n");
+    if (first == std::string_view::npos) {
+        return std::string();
+    }
+    desc = desc.substr(first, desc.find_last_not_of(" \t\r\n") + 1 - first);
+
+    // Replace multiple spaces with single space
+    std::string cleaned;
+    cleaned.reserve(desc.size());
+    bool inSpace = false;
+    for (char c : desc) {
+        if (isSpaceChar(c)) {
+            if (!inSpace) {
+                cleaned += ' ';
+            }
+            inSpace = true;
+        } else {
+            cleaned += c;
+            inSpace = false;
+        }
+    }
+    return cleaned;
+}
+
+// Equivalent of ^\s*\d+\.?\d*\s*$
+bool isNumericText(std::string_view text) {
+    size_t i = 0;
+    while (i < text.size() && isSpaceChar(text[i])) ++i;
+
+    size_t digitsStart = i;
+    while (i < text.size() && isDigitChar(text[i])) ++i;
+    if (i == digitsStart) {
+        return false;
+    }
+
+    if (i < text.size() && text[i] == '.') ++i;
+    while (i < text.size() && isDigitChar(text[i])) ++i;
+    while (i < text.size() && isSpaceChar(text[i])) ++i;
+    return i == text.size();
+}
+
+} // namespace BankAnalyzer
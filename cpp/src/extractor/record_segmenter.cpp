@@ -0,0 +1,229 @@
+#include "record_segmenter.h"
+#include "text_scan.h"
+#include "kernels.h"
+#include <algorithm>
+
+namespace BankAnalyzer {
+
+namespace {
+
+// Text per kernel thread when segmentation is split across threads; below
+// this the threads cost more than they save
+constexpr size_t kParallelChunkBytes = 1u << 20;
+
+// An anchor starts a whitespace-separated token ("4 918,16" is one amount,
+// not a day and a month)
+bool startsToken(std::string_view text, size_t pos) {
+    return pos == 0 || isSpaceChar(text[pos - 1]);
+}
+
+size_t followedBySpace(std::string_view text, size_t end) {
+    return end != kNoMatch && end < text.size() && isSpaceChar(text[end]) ? end : kNoMatch;
+}
+
+// Month[a-z]*, with the French names Pattern 8 adds to the English ones
+// (Janv, Mars and Sept already start with an English name)
+size_t scanAnyMonthName(std::string_view text, size_t pos) {
+    size_t end = scanMonthName(text, pos);
+    if (end != kNoMatch) {
+        return end;
+    }
+    static constexpr std::string_view kFrenchMonths[] = {"Févr", "Avr", "Mai", "Juin", "Juil", "Août"};
+    for (std::string_view month : kFrenchMonths) {
+        if (text.substr(pos, month.size()) == month) {
+            size_t i = pos + month.size();
+            while (i < text.size() && text[i] >= 'a' && text[i] <= 'z') ++i;
+            return i;
+        }
+    }
+    return kNoMatch;
+}
+
+// Any date a pattern starts with, followed by whitespace. Returns its end.
+size_t scanAnchorDate(std::string_view text, size_t pos) {
+    // Month\s+\d{1,2}
+    if (isLetterChar(text[pos])) {
+        size_t monthEnd = scanAnyMonthName(text, pos);
+        if (monthEnd == kNoMatch) {
+            return kNoMatch;
+        }
+        size_t dayStart = skipSpaces(text, monthEnd);
+        size_t digits = digitRun(text, dayStart, 3);
+        if (dayStart == monthEnd || digits == 0 || digits == 3) {
+            return kNoMatch;
+        }
+        return followedBySpace(text, dayStart + digits);
+    }
+    if (!isDigitChar(text[pos])) {
+        return kNoMatch;
+    }
+
+    // d/m/y, ISO
+    size_t end = followedBySpace(text, scanNumericDate(text, pos));
+    if (end == kNoMatch) {
+        end = followedBySpace(text, scanIsoDate(text, pos));
+    }
+    if (end != kNoMatch) {
+        return end;
+    }
+
+    size_t digits = digitRun(text, pos, 3);
+    if (digits == 0 || digits == 3) {
+        return kNoMatch;
+    }
+    size_t i = pos + digits;
+
+    // d/m (Pattern 10)
+    if (i < text.size() && (text[i] == '/' || text[i] == '-')) {
+        size_t monthDigits = digitRun(text, i + 1, 3);
+        if (monthDigits == 0 || monthDigits == 3) {
+            return kNoMatch;
+        }
+        return followedBySpace(text, i + 1 + monthDigits);
+    }
+
+    // \d{1,2}\s+Month (Pattern 1)
+    size_t monthStart = skipSpaces(text, i);
+    if (monthStart == i) {
+        return kNoMatch;
+    }
+    return followedBySpace(text, scanMonthName(text, monthStart));
+}
+
+// Where the record of the anchor at pos starts: at the check number or ****
+// in front of the date, if there is one (Pattern 4), else at the date.
+// The record can't reach back past floor, the end of the previous anchor.
+size_t recordStart(std::string_view text, size_t pos, size_t floor) {
+    size_t tokenEnd = pos;
+    while (tokenEnd > floor && isSpaceChar(text[tokenEnd - 1])) --tokenEnd;
+    if (tokenEnd == pos) {
+        return pos;
+    }
+
+    size_t tokenStart = tokenEnd;
+    while (tokenStart > floor && isDigitChar(text[tokenStart - 1])) --tokenStart;
+    size_t digits = tokenEnd - tokenStart;
+    if (digits == 0 && tokenEnd >= floor + 4 && text.substr(tokenEnd - 4, 4) == "****") {
+        tokenStart = tokenEnd - 4;
+    } else if (digits < 3 || digits > 6) {
+        return pos;
+    }
+    return startsToken(text, tokenStart) ? tokenStart : pos;
+}
+
+// \d[.,]\d\d not followed by another digit: the cents of an amount in any of
+// the patterns' formats. Every transaction row has one.
+bool containsAmount(std::string_view text, size_t begin, size_t end, const KernelSet& kernels) {
+    return kernels.findCents(text.data(), text.size(), begin, end) != end;
+}
+
+struct Anchor {
+    size_t pos;
+    size_t end;                 // kNoMatch: no anchor
+};
+
+// The first anchor starting in [pos, limit). Anchors start tokens with a
+// digit or a capital (month names are capitalized), so only those are tried.
+Anchor nextAnchor(std::string_view text, size_t pos, size_t limit, const KernelSet& kernels) {
+    if (pos == 0 && limit > 0) {
+        size_t end = scanAnchorDate(text, 0);
+        if (end != kNoMatch) {
+            return {0, end};
+        }
+    }
+    while (true) {
+        pos = kernels.findTokenStart(text.data(), limit, pos);
+        if (pos >= limit) {
+            return {limit, kNoMatch};
+        }
+        size_t end = scanAnchorDate(text, pos);
+        if (end != kNoMatch) {
+            return {pos, end};
+        }
+        ++pos;
+    }
+}
+
+// Every anchor in the text, in order, found by kernel threads over chunks of
+// it. Unlike the walk in segmentRecords(), a chunk also reports anchors that
+// start inside an earlier one; the walk skips those.
+std::vector<Anchor> findAnchors(std::string_view text, size_t chunks, const KernelSet& kernels) {
+    std::vector<std::vector<Anchor>> found(chunks);
+    forEachChunk(chunks, [&](size_t chunk) {
+        size_t begin = text.size() * chunk / chunks;
+        size_t end = text.size() * (chunk + 1) / chunks;
+        for (Anchor anchor = nextAnchor(text, begin, end, kernels); anchor.end != kNoMatch;
+             anchor = nextAnchor(text, anchor.pos + 1, end, kernels)) {
+            found[chunk].push_back(anchor);
+        }
+    });
+
+    std::vector<Anchor> anchors;
+    for (const auto& part : found) {
+        anchors.insert(anchors.end(), part.begin(), part.end());
+    }
+    return anchors;
+}
+
+// Add [begin, end) as records of at most kMaxRecordBytes. An oversize window
+// is cut from its end backwards, at whitespace where there is some, so the
+// last piece keeps the row that gave the window its amount.
+void addRecord(std::vector<RecordWindow>& records, std::string_view text, size_t begin, size_t end) {
+    size_t first = records.size();
+    while (end - begin > kMaxRecordBytes) {
+        size_t cut = end - kMaxRecordBytes;
+        while (cut < end && !isSpaceChar(text[cut])) ++cut;
+        if (cut == end) {
+            cut = end - kMaxRecordBytes;
+        }
+        records.push_back({cut, end});
+        end = cut;
+    }
+    records.push_back({begin, end});
+    std::reverse(records.begin() + first, records.end());
+}
+
+} // namespace
+
+std::vector<RecordWindow> segmentRecords(std::string_view text) {
+    const KernelSet& scan = kernels();
+    std::vector<RecordWindow> records;
+    size_t begin = 0;           // Start of the window being built
+    size_t probed = 0;          // [begin, probed) has been searched for an amount
+    bool hasAmount = false;
+    size_t floor = 0;           // End of the last anchor
+
+    auto addAnchor = [&](const Anchor& anchor) {
+        // Close the window here unless it has no amount yet
+        size_t cut = recordStart(text, anchor.pos, floor);
+        hasAmount = hasAmount || containsAmount(text, probed, cut, scan);
+        probed = cut;
+        if (hasAmount && cut > begin) {
+            addRecord(records, text, begin, cut);
+            begin = cut;
+            hasAmount = false;
+        }
+        floor = anchor.end;
+    };
+
+    size_t chunks = chunkCount(text.size(), kParallelChunkBytes);
+    if (chunks > 1) {
+        for (const Anchor& anchor : findAnchors(text, chunks, scan)) {
+            if (anchor.pos >= floor) {
+                addAnchor(anchor);
+            }
+        }
+    } else {
+        for (Anchor anchor = nextAnchor(text, 0, text.size(), scan); anchor.end != kNoMatch;
+             anchor = nextAnchor(text, floor, text.size(), scan)) {
+            addAnchor(anchor);
+        }
+    }
+
+    if (begin < text.size()) {
+        addRecord(records, text, begin, text.size());
+    }
+    return records;
+}
+
+} // namespace BankAnalyzer
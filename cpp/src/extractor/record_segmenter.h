@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace BankAnalyzer {
+
+/**
+ * Longest record window segmentRecords() produces. Statement rows are well
+ * under 256 bytes, even with a dual-date row's windows joined.
+ */
+constexpr size_t kMaxRecordBytes = 1024;
+
+/**
+ * One candidate transaction record: [begin, end) of the statement text
+ */
+struct RecordWindow {
+    size_t begin;
+    size_t end;
+};
+
+/**
+ * Cut statement text into candidate records at date anchors.
+ *
+ * PDF.js text has no reliable line breaks, so a pattern matched over the
+ * whole document lets its lazy description group run on through the rows
+ * that follow. Patterns match inside one record at a time instead: regex
+ * work is bounded by the record length and a match can't swallow the next
+ * transaction.
+ *
+ * An anchor is a date in any form a pattern starts with (month name and day
+ * in either order, English or French months, d/m, d/m/y, ISO) that starts a
+ * token and is followed by whitespace. A check number or **** just before
+ * it opens the same record (Pattern 4). A window runs from one anchor to the
+ * next, but one with no amount in it can't be a whole row (dual-date layouts,
+ * a date inside a description), so it is joined to the window after it.
+ *
+ * No window is longer than kMaxRecordBytes: a longer one (a date followed by
+ * a page of text with no line breaks) is cut into pieces, keeping its end,
+ * where the row with the amount is, whole. The regex patterns recurse per
+ * character searched, so an unbounded window could overflow the stack.
+ *
+ * The windows cover the text end to end, in order; text before the first
+ * anchor is a window of its own. Runs in one pass over the text, skipping
+ * from token to token with the dispatched kernels (kernels.h); with more than
+ * one kernel thread, a large text is searched for anchors a chunk per thread.
+ */
+std::vector<RecordWindow> segmentRecords(std::string_view text);
+
+/**
+ * The text of one record
+ */
+inline std::string_view recordText(std::string_view text, const RecordWindow& record) {
+    return text.substr(record.begin, record.end - record.begin);
+}
+
+} // namespace BankAnalyzer
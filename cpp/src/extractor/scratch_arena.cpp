@@ -0,0 +1,267 @@
+#include "scratch_arena.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+
+namespace BankAnalyzer {
+
+namespace {
+
+constexpr size_t kAlignment = 16;
+
+// Arena receiving this thread's allocations (nullptr outside a ScratchScope)
+thread_local ScratchArena* routedArena = nullptr;
+
+// This thread's arena once created, for ownership checks on delete
+thread_local ScratchArena* threadArena = nullptr;
+
+size_t alignUp(size_t size) {
+    return (size + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+// Every live chunk of every thread's arena. A block can be freed on a thread
+// other than the one whose arena it came from (a std::thread's state freed by
+// the new thread, a future's shared state), and must not reach free().
+// Slots are claimed and cleared with atomics, so a lookup never locks; in
+// static storage, the table is zeroed before any operator new runs.
+constexpr size_t kMaxLiveChunks = 1024;
+constexpr uintptr_t kClaimedSlot = 1;       // Start of a slot being filled in
+
+struct LiveChunk {
+    std::atomic<uintptr_t> start;           // 0: free
+    std::atomic<uintptr_t> end;
+};
+
+LiveChunk liveChunks[kMaxLiveChunks];
+std::atomic<size_t> liveChunkSlots{0};      // Lookups scan slots below this
+std::atomic<uintptr_t> liveLow{UINTPTR_MAX};    // Bounds of every chunk ever registered
+std::atomic<uintptr_t> liveHigh{0};
+
+// Slot for a new chunk, or kMaxLiveChunks if the table is full
+size_t registerChunk(uintptr_t start, uintptr_t end) {
+    for (size_t slot = 0; slot < kMaxLiveChunks; ++slot) {
+        uintptr_t expected = 0;
+        if (!liveChunks[slot].start.compare_exchange_strong(expected, kClaimedSlot, std::memory_order_acquire)) {
+            continue;
+        }
+        liveChunks[slot].end.store(end, std::memory_order_relaxed);
+        liveChunks[slot].start.store(start, std::memory_order_release);
+
+        size_t slots = liveChunkSlots.load(std::memory_order_relaxed);
+        while (slots <= slot && !liveChunkSlots.compare_exchange_weak(slots, slot + 1, std::memory_order_release)) {
+        }
+        uintptr_t low = liveLow.load(std::memory_order_relaxed);
+        while (start < low && !liveLow.compare_exchange_weak(low, start, std::memory_order_relaxed)) {
+        }
+        uintptr_t high = liveHigh.load(std::memory_order_relaxed);
+        while (end > high && !liveHigh.compare_exchange_weak(high, end, std::memory_order_relaxed)) {
+        }
+        return slot;
+    }
+    return kMaxLiveChunks;
+}
+
+void unregisterChunk(size_t slot) {
+    liveChunks[slot].end.store(0, std::memory_order_relaxed);
+    liveChunks[slot].start.store(0, std::memory_order_release);
+}
+
+bool inLiveChunk(const void* p) {
+    uintptr_t address = reinterpret_cast<uintptr_t>(p);
+    if (address < liveLow.load(std::memory_order_relaxed) || address >= liveHigh.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    size_t slots = liveChunkSlots.load(std::memory_order_acquire);
+    for (size_t slot = 0; slot < slots; ++slot) {
+        uintptr_t start = liveChunks[slot].start.load(std::memory_order_acquire);
+        if (start > kClaimedSlot && address >= start && address < liveChunks[slot].end.load(std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+void* scratchAllocate(size_t size) {
+    return routedArena ? routedArena->allocate(size) : nullptr;
+}
+
+bool scratchRelease(const void* p, size_t size) {
+    if (threadArena && threadArena->owns(p)) {
+        if (size != 0) {
+            threadArena->releaseTop(p, size);
+        }
+        return true;
+    }
+    // Another thread's arena: reclaimed when that arena rewinds
+    return inLiveChunk(p);
+}
+
+ScratchArena& ScratchArena::forThisThread() {
+    thread_local ScratchArena arena;
+    threadArena = &arena;
+    return arena;
+}
+
+ScratchArena::ScratchArena() {
+}
+
+ScratchArena::~ScratchArena() {
+    if (routedArena == this) {
+        routedArena = nullptr;
+    }
+    if (threadArena == this) {
+        threadArena = nullptr;
+    }
+    releaseChunksFrom(0);
+}
+
+void* ScratchArena::allocate(size_t size) {
+    size = alignUp(size ? size : 1);
+
+    for (;;) {
+        while (current_ < chunkCount_) {
+            Chunk& chunk = chunks_[current_];
+            if (offset_ + size <= chunk.size) {
+                void* p = chunk.data + offset_;
+                offset_ += size;
+                used_ += size;
+                peak_ = std::max(peak_, used_);
+                return p;
+            }
+            ++current_;
+            offset_ = 0;
+        }
+        if (!addChunk(size)) {
+            ++overflowAllocations_;
+            return nullptr;
+        }
+    }
+}
+
+bool ScratchArena::owns(const void* p) const {
+    uintptr_t address = reinterpret_cast<uintptr_t>(p);
+    if (address < low_ || address >= high_) {
+        return false;
+    }
+    for (size_t i = 0; i < chunkCount_; ++i) {
+        uintptr_t start = reinterpret_cast<uintptr_t>(chunks_[i].data);
+        if (address >= start && address < start + chunks_[i].size) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ScratchArena::releaseTop(const void* p, size_t size) {
+    if (current_ >= chunkCount_) {
+        return;
+    }
+    size = alignUp(size ? size : 1);
+    if (size <= offset_ && p == chunks_[current_].data + offset_ - size) {
+        offset_ -= size;
+        used_ -= size;
+    }
+}
+
+void ScratchArena::reset() {
+    current_ = 0;
+    offset_ = 0;
+    used_ = 0;
+    peak_ = 0;
+    overflowAllocations_ = 0;
+
+    // Honour a lowered capacity by dropping the newest (largest) chunks
+    size_t keep = chunkCount_;
+    size_t reserved = reserved_;
+    while (keep > 0 && reserved > capacity_) {
+        --keep;
+        reserved -= chunks_[keep].size;
+    }
+    releaseChunksFrom(keep);
+}
+
+void ScratchArena::rewind(const Mark& mark) {
+    current_ = mark.chunk;
+    offset_ = mark.offset;
+    used_ = mark.used;
+}
+
+bool ScratchArena::addChunk(size_t minimumSize) {
+    if (chunkCount_ == kMaxChunks || reserved_ + minimumSize > capacity_) {
+        return false;
+    }
+
+    // Geometric growth, trimmed to what the cap still allows
+    size_t size = chunkCount_ == 0 ? kFirstChunkSize : chunks_[chunkCount_ - 1].size * 2;
+    size = std::max(size, minimumSize);
+    size = std::min(size, capacity_ - reserved_);
+
+    // Chunks come straight from malloc so they never recurse into operator new
+    void* raw = std::malloc(size + kAlignment - 1);
+    if (!raw) {
+        return false;
+    }
+    char* data = reinterpret_cast<char*>(alignUp(reinterpret_cast<uintptr_t>(raw)));
+    size_t slot = registerChunk(reinterpret_cast<uintptr_t>(data), reinterpret_cast<uintptr_t>(data) + size);
+    if (slot == kMaxLiveChunks) {
+        std::free(raw);
+        return false;
+    }
+
+    chunks_[chunkCount_++] = {raw, data, size, slot};
+    reserved_ += size;
+    current_ = chunkCount_ - 1;
+    offset_ = 0;
+    updateBounds();
+    return true;
+}
+
+void ScratchArena::releaseChunksFrom(size_t index) {
+    while (chunkCount_ > index) {
+        --chunkCount_;
+        reserved_ -= chunks_[chunkCount_].size;
+        unregisterChunk(chunks_[chunkCount_].slot);
+        std::free(chunks_[chunkCount_].raw);
+    }
+    current_ = std::min(current_, chunkCount_);
+    updateBounds();
+}
+
+void ScratchArena::updateBounds() {
+    low_ = UINTPTR_MAX;
+    high_ = 0;
+    for (size_t i = 0; i < chunkCount_; ++i) {
+        uintptr_t start = reinterpret_cast<uintptr_t>(chunks_[i].data);
+        low_ = std::min(low_, start);
+        high_ = std::max(high_, start + chunks_[i].size);
+    }
+}
+
+ScratchScope::ScratchScope() : arena_(ScratchArena::forThisThread()) {
+#if TELLER_SCRATCH_ARENA
+    if (arena_.depth_ == 0) {
+        arena_.reset();
+    }
+    ++arena_.depth_;
+    previousRouting_ = routedArena == &arena_;
+    routedArena = &arena_;
+    active_ = true;
+#endif
+}
+
+ScratchScope::~ScratchScope() {
+    release();
+}
+
+void ScratchScope::release() {
+    if (!active_) {
+        return;
+    }
+    active_ = false;
+    --arena_.depth_;
+    routedArena = previousRouting_ ? &arena_ : nullptr;
+}
+
+} // namespace BankAnalyzer
@@ -0,0 +1,158 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Compile-time switch for the scratch arena.
+// Build with -DTELLER_SCRATCH_ARENA=OFF (CMake) to leave every allocation on
+// the regular heap; ScratchScope then does nothing.
+#ifndef TELLER_SCRATCH_ARENA
+#define TELLER_SCRATCH_ARENA 1
+#endif
+
+namespace BankAnalyzer {
+
+/**
+ * Monotonic arena for the short-lived allocations of one extraction or
+ * analysis call (strings, regex state, intermediate vectors).
+ *
+ * While a ScratchScope is open on a thread, every operator new on that thread
+ * bump-allocates from the thread's arena and operator delete of arena memory
+ * only reclaims the most recent block. The next outermost scope rewinds the arena instead of returning
+ * memory to the heap, so a session that processes many statements reuses the
+ * same chunks: WASM memory (which never shrinks) stops growing after the
+ * largest statement, and the heap doesn't fragment into per-row strings.
+ *
+ * Chunks grow geometrically up to capacity(); past it, allocations fall back
+ * to the heap and are counted in overflowAllocations().
+ *
+ * Arena memory may be freed on any thread: delete finds the owning arena by
+ * address among every thread's live chunks and leaves the block for that
+ * arena's rewind. It must still be dead by the owner's next rewind and must
+ * not outlive the owning thread.
+ */
+class ScratchArena {
+public:
+    static constexpr size_t kDefaultCapacity = 64u << 20;   // 64 MB
+    static constexpr size_t kFirstChunkSize = 64u << 10;    // 64 KB
+
+    /**
+     * The calling thread's arena (created on first use)
+     */
+    static ScratchArena& forThisThread();
+
+    ScratchArena();
+    ~ScratchArena();
+
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    /**
+     * 16-byte aligned block, or nullptr if it would exceed the capacity
+     */
+    void* allocate(size_t size);
+
+    bool owns(const void* p) const;
+
+    /**
+     * Give back the most recent block (a no-op for anything older). Covers
+     * the allocate/free churn of regex matching and temporary strings.
+     */
+    void releaseTop(const void* p, size_t size);
+
+    /**
+     * Rewind to empty; chunks are kept for the next call
+     */
+    void reset();
+
+    /**
+     * Position to rewind() back to once everything allocated after it is dead
+     * (e.g. a pattern that found nothing)
+     */
+    struct Mark {
+        size_t chunk;
+        size_t offset;
+        size_t used;
+    };
+    Mark mark() const { return {current_, offset_, used_}; }
+    void rewind(const Mark& mark);
+
+    /**
+     * Cap on memory held by the arena. Lowering it releases chunks beyond the
+     * new cap at the next reset.
+     */
+    void setCapacity(size_t bytes) { capacity_ = bytes; }
+    size_t capacity() const { return capacity_; }
+
+    size_t used() const { return used_; }                   // Bytes handed out since the last reset
+    size_t peak() const { return peak_; }                   // Highest used() since the last reset
+    size_t reserved() const { return reserved_; }           // Bytes held in chunks
+    uint64_t overflowAllocations() const { return overflowAllocations_; }  // Since the last reset
+
+private:
+    friend class ScratchScope;
+
+    struct Chunk {
+        void* raw;                // As returned by malloc
+        char* data;               // 16-byte aligned start
+        size_t size;
+        size_t slot;              // In the table of live chunks (scratch_arena.cpp)
+    };
+    static constexpr size_t kMaxChunks = 32;
+
+    bool addChunk(size_t minimumSize);
+    void releaseChunksFrom(size_t index);
+    void updateBounds();
+
+    Chunk chunks_[kMaxChunks];
+    size_t chunkCount_ = 0;
+    size_t current_ = 0;          // Chunk being bumped
+    size_t offset_ = 0;           // Bump offset in the current chunk
+    size_t used_ = 0;
+    size_t peak_ = 0;
+    size_t reserved_ = 0;
+    size_t capacity_ = kDefaultCapacity;
+    uintptr_t low_ = UINTPTR_MAX; // Bounds of all chunks, for a quick owns() reject
+    uintptr_t high_ = 0;
+    uint64_t overflowAllocations_ = 0;
+    int depth_ = 0;               // Nested ScratchScopes
+};
+
+// Hooks for the replacement operator new/delete in extractor_stats.cpp
+void* scratchAllocate(size_t size);     // nullptr unless a ScratchScope is routing and the arena has room
+bool scratchRelease(const void* p, size_t size = 0);   // true if p is any thread's arena memory (nothing to free)
+
+/**
+ * Routes the calling thread's allocations into its scratch arena for the
+ * lifetime of the scope. The outermost scope rewinds the arena on entry.
+ * Anything that must outlive the call has to be copied out with copyOut(),
+ * which closes the scope first so the copy lands on the regular heap.
+ */
+class ScratchScope {
+public:
+    ScratchScope();
+    ~ScratchScope();
+
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+
+    /**
+     * Stop routing allocations into the arena (arena memory stays valid
+     * until the next outermost scope opens)
+     */
+    void release();
+
+    template <typename T>
+    T copyOut(const T& value) {
+        release();
+        return T(value);
+    }
+
+    ScratchArena& arena() { return arena_; }
+
+private:
+    ScratchArena& arena_;
+    bool previousRouting_ = false;
+    bool active_ = false;
+};
+
+} // namespace BankAnalyzer
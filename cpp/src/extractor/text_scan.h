@@ -0,0 +1,124 @@
+#pragma once
+#include <cstddef>
+#include <string_view>
+
+namespace BankAnalyzer {
+
+/**
+ * Lexing primitives for the hand-written pattern scanners.
+ * Each one matches exactly what the equivalent std::regex fragment (ECMAScript
+ * grammar, "C" locale) would, so scanners and regex patterns agree on which
+ * rows they accept. Functions return the position after the match, or
+ * kNoMatch.
+ */
+constexpr size_t kNoMatch = std::string_view::npos;
+
+// \s
+inline bool isSpaceChar(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+// \d
+inline bool isDigitChar(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// Characters '.' does not match
+inline bool isLineBreak(char c) {
+    return c == '\n' || c == '\r';
+}
+
+// [A-Za-z]
+inline bool isLetterChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+// \s*
+inline size_t skipSpaces(std::string_view text, size_t pos) {
+    while (pos < text.size() && isSpaceChar(text[pos])) ++pos;
+    return pos;
+}
+
+// Length of the digit run at pos, counting at most limit digits
+inline size_t digitRun(std::string_view text, size_t pos, size_t limit) {
+    size_t n = 0;
+    while (n < limit && pos + n < text.size() && isDigitChar(text[pos + n])) ++n;
+    return n;
+}
+
+// \d{1,3}(?:,\d{3})*\.\d{2}
+inline size_t scanAmount(std::string_view text, size_t pos) {
+    size_t digits = digitRun(text, pos, 4);
+    if (digits == 0 || digits == 4) {
+        return kNoMatch;
+    }
+    size_t i = pos + digits;
+    while (i + 3 < text.size() && text[i] == ',' &&
+           isDigitChar(text[i + 1]) && isDigitChar(text[i + 2]) && isDigitChar(text[i + 3])) {
+        i += 4;
+    }
+    if (i + 2 < text.size() && text[i] == '.' && isDigitChar(text[i + 1]) && isDigitChar(text[i + 2])) {
+        return i + 3;
+    }
+    return kNoMatch;
+}
+
+// (?:Jan|Feb|Mar|Apr|May|Jun|Jul|Aug|Sep|Oct|Nov|Dec)[a-z]*
+inline size_t scanMonthName(std::string_view text, size_t pos) {
+    static constexpr std::string_view kMonths[] = {
+        "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+    };
+    if (pos + 3 > text.size()) {
+        return kNoMatch;
+    }
+    std::string_view prefix = text.substr(pos, 3);
+    for (std::string_view month : kMonths) {
+        if (prefix == month) {
+            size_t i = pos + 3;
+            while (i < text.size() && text[i] >= 'a' && text[i] <= 'z') ++i;
+            return i;
+        }
+    }
+    return kNoMatch;
+}
+
+// Month[a-z]*\s+\d{1,2}, where a following \s is required (as in every pattern using it)
+inline size_t scanMonthDay(std::string_view text, size_t pos) {
+    size_t monthEnd = scanMonthName(text, pos);
+    if (monthEnd == kNoMatch) {
+        return kNoMatch;
+    }
+    size_t dayStart = skipSpaces(text, monthEnd);
+    size_t digits = digitRun(text, dayStart, 3);
+    if (dayStart == monthEnd || digits == 0 || digits == 3) {
+        return kNoMatch;
+    }
+    return dayStart + digits;
+}
+
+// \d{1,2}[/-]\d{1,2}[/-]\d{2,4}, where a following \s is required
+inline size_t scanNumericDate(std::string_view text, size_t pos) {
+    size_t i = pos;
+    for (int part = 0; part < 2; ++part) {
+        size_t digits = digitRun(text, i, 3);
+        if (digits == 0 || digits == 3 || i + digits >= text.size() ||
+            (text[i + digits] != '/' && text[i + digits] != '-')) {
+            return kNoMatch;
+        }
+        i += digits + 1;
+    }
+    size_t year = digitRun(text, i, 4);
+    return year >= 2 ? i + year : kNoMatch;
+}
+
+// \d{4}-\d{2}-\d{2}
+inline size_t scanIsoDate(std::string_view text, size_t pos) {
+    if (digitRun(text, pos, 4) == 4 && pos + 4 < text.size() && text[pos + 4] == '-' &&
+        digitRun(text, pos + 5, 2) == 2 && pos + 7 < text.size() && text[pos + 7] == '-' &&
+        digitRun(text, pos + 8, 2) == 2) {
+        return pos + 10;
+    }
+    return kNoMatch;
+}
+
+} // namespace BankAnalyzer
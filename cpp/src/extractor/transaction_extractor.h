@@ -1,34 +1,110 @@
 #pragma once
+#include "extractor_stats.h"
+#include "match_budget.h"
+#include "money.h"
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace BankAnalyzer {
 
+struct PatternPack;
+struct PatternDefinition;
+
 struct Transaction {
     std::string date;
     std::string description;
-    double amount;
-    double balance;
+    Money amount;                 // Magnitude; the direction is in type
+    Money balance;                // Running balance after this row, if the statement prints one
     std::string type; // "debit" or "credit"
     std::string category; // transaction category (e.g., "groceries", "utilities")
+    bool hasBalance = false;      // balance was read from the statement's balance column
+    bool balanceMismatch = false; // balance doesn't follow from the previous one (see balance_reconciliation.h)
+    bool creditKeyword = false;   // description has a money-in keyword (kKeywordCredit), for rows left without a type
+    std::string account;          // Statement/account the row came from, set by the caller when
+                                  // ledgers are combined (see transfer_matcher.h); empty if unknown
 };
 
 class TransactionExtractor {
 public:
+    /**
+     * Starts with the base pattern pack (Patterns 2, 1, 3; no std::regex).
+     * Add extendedPatternPack() for the other seven (see pattern_pack.h).
+     */
     TransactionExtractor();
     ~TransactionExtractor();
 
     /**
-     * Extract transactions from raw text using 10 regex patterns
+     * Starts with only the given pack (the WASM pattern pack module runs the
+     * extended pack on its own, after the base module found nothing)
+     */
+    explicit TransactionExtractor(const PatternPack& pack);
+
+    /**
+     * Append a pattern pack to the cascade. Adding a pack twice is a no-op.
+     */
+    void addPatternPack(const PatternPack& pack);
+
+    /**
+     * Extract transactions from raw text using the loaded pattern packs.
+     * Per-pattern timings and match/reject counts are available from stats()
+     * afterwards. Each pattern runs under the step budget from limits(); one
+     * that exceeds it is abandoned (stats().pattern(n).aborted) and the
+     * cascade continues, until the document deadline stops it altogether
+     * (stats().deadlineExceeded).
      * Patterns handle 95-98% of North American bank statement formats
-     * @param text Text extracted from PDF
+     * @param text Text extracted from PDF (may point into a memory-mapped file)
      * @return Vector of transactions
      */
-    std::vector<Transaction> extract(const std::string& text);
+    std::vector<Transaction> extract(std::string_view text);
+
+    // For a UI thread that can't block on a long statement, ExtractionJob
+    // (extraction_job.h) runs the same cascade in resumable, cancellable steps
+
+    /**
+     * Run a single pattern without the fallback cascade.
+     * Used by teller-bench and for checking which pattern fits a bank's layout.
+     * @param pattern Pattern number (1-10, see PATTERNS.md)
+     * @param text Text extracted from PDF
+     * @return Transactions found by that pattern (empty if its pack isn't loaded)
+     */
+    std::vector<Transaction> extractWithPattern(int pattern, std::string_view text);
+
+    /**
+     * Human-readable name of a pattern, e.g. "Check-Heavy Format"
+     */
+    static const char* patternName(int pattern);
+
+    /**
+     * Pattern numbers in the order extract() tries them
+     */
+    std::vector<int> patternCascade() const;
+
+    /**
+     * Metrics for the most recent extract()/extractWithPattern() call.
+     * Timings, counters and allocations are zero when built with
+     * TELLER_METRICS off; matchedPattern is always filled in.
+     */
+    const ExtractorStats& stats() const { return stats_; }
+
+    /**
+     * Work budget and deadline applied to every extraction
+     */
+    void setLimits(const ExtractionLimits& limits) { limits_ = limits; }
+    const ExtractionLimits& limits() const { return limits_; }
+
+    static constexpr int kPatternCount = ExtractorStats::kPatternCount;
 
 private:
-    // Pattern matching implemented in transaction_extractor.cpp
+    friend class ExtractionJob;     // Runs the same cascade a slice at a time (extraction_job.h)
+
+    const PatternDefinition* findPattern(int pattern) const;
+
+    // Patterns are implemented in base_patterns.cpp and extended_patterns.cpp
     // See PATTERNS.md for detailed documentation of all 10 patterns
+    std::vector<const PatternPack*> packs_;
+    ExtractorStats stats_;
+    ExtractionLimits limits_;
 };
 
 } // namespace BankAnalyzer
@@ -0,0 +1,22 @@
+#pragma once
+#include "kernels.h"
+
+namespace BankAnalyzer {
+
+// Kernel set internals, shared by kernels.cpp and the kernels_<isa>.cpp files.
+// These are compiled without any extra instruction sets, so the vector sets
+// call them for their tails without pulling wider code into a scalar path.
+
+size_t findTokenStartScalar(const char* text, size_t size, size_t pos);
+size_t findCentsScalar(const char* text, size_t size, size_t begin, size_t end);
+
+#if TELLER_KERNELS_X86
+const KernelSet& sse2Kernels();
+const KernelSet& avx2Kernels();
+#endif
+
+#ifdef __wasm_simd128__
+const KernelSet& simd128Kernels();
+#endif
+
+} // namespace BankAnalyzer
@@ -0,0 +1,154 @@
+#include "kernels.h"
+#include "kernel_sets.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#if TELLER_THREADS
+#include <system_error>
+#include <thread>
+#endif
+
+namespace BankAnalyzer {
+
+namespace {
+
+bool isSpace(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+bool isDigitOrCapital(char c) {
+    return isDigit(c) || (c >= 'A' && c <= 'Z');
+}
+
+const KernelSet kScalarKernels = {
+    "scalar",
+    findTokenStartScalar,
+    findCentsScalar,
+};
+
+// The widest set available; resolved on first use
+std::atomic<const KernelSet*>& activeKernels() {
+    static std::atomic<const KernelSet*> active{availableKernelSets().back()};
+    return active;
+}
+
+std::atomic<size_t> threadCount{1};
+
+} // namespace
+
+size_t findTokenStartScalar(const char* text, size_t size, size_t pos) {
+    for (size_t p = pos > 0 ? pos : 1; p < size; ++p) {
+        if (isSpace(text[p - 1]) && isDigitOrCapital(text[p])) {
+            return p;
+        }
+    }
+    return size;
+}
+
+size_t findCentsScalar(const char* text, size_t size, size_t begin, size_t end) {
+    for (size_t i = begin; i + 3 < end; ++i) {
+        if (isDigit(text[i]) && (text[i + 1] == '.' || text[i + 1] == ',') &&
+            isDigit(text[i + 2]) && isDigit(text[i + 3]) &&
+            (i + 4 == size || !isDigit(text[i + 4]))) {
+            return i;
+        }
+    }
+    return end;
+}
+
+const KernelSet& kernels() {
+    return *activeKernels().load(std::memory_order_relaxed);
+}
+
+std::vector<const KernelSet*> availableKernelSets() {
+    std::vector<const KernelSet*> sets{&kScalarKernels};
+#if TELLER_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) {
+        sets.push_back(&sse2Kernels());
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        sets.push_back(&avx2Kernels());
+    }
+#endif
+#ifdef __wasm_simd128__
+    sets.push_back(&simd128Kernels());
+#endif
+    return sets;
+}
+
+bool selectKernelSet(std::string_view name) {
+    for (const KernelSet* set : availableKernelSets()) {
+        if (name == set->name) {
+            activeKernels().store(set, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t kernelThreads() {
+    return threadCount.load(std::memory_order_relaxed);
+}
+
+void setKernelThreads(size_t threads) {
+#if TELLER_THREADS
+#ifdef TELLER_MAX_KERNEL_THREADS
+    threads = std::min<size_t>(threads, TELLER_MAX_KERNEL_THREADS);
+#endif
+    threadCount.store(std::max<size_t>(threads, 1), std::memory_order_relaxed);
+#else
+    (void)threads;
+#endif
+}
+
+size_t chunkCount(size_t count, size_t minChunk) {
+    size_t chunks = minChunk > 0 ? count / minChunk : count;
+    return std::max<size_t>(1, std::min(chunks, kernelThreads()));
+}
+
+void forEachChunk(size_t chunks, const std::function<void(size_t chunk)>& fn) {
+#if TELLER_THREADS
+    std::vector<std::exception_ptr> errors(chunks);
+    auto run = [&](size_t chunk) {
+        try {
+            fn(chunk);
+        } catch (...) {
+            errors[chunk] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(chunks > 0 ? chunks - 1 : 0);
+    size_t started = 1;
+    try {
+        for (; started < chunks; ++started) {
+            workers.emplace_back(run, started);
+        }
+    } catch (const std::system_error&) {
+        // Out of threads: the rest run here
+    }
+    if (chunks > 0) {
+        run(0);
+    }
+    for (size_t chunk = started; chunk < chunks; ++chunk) {
+        run(chunk);
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    for (const std::exception_ptr& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+#else
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        fn(chunk);
+    }
+#endif
+}
+
+} // namespace BankAnalyzer
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+// Compile-time switch for threaded kernels.
+// Native builds link a thread library; WASM modules only have threads in the
+// simd-threads variant (TELLER_WASM_VARIANT). Without it forEachChunk() runs
+// every chunk on the calling thread.
+#ifndef TELLER_THREADS
+#define TELLER_THREADS 0
+#endif
+
+namespace BankAnalyzer {
+
+/**
+ * The hot inner loops, one implementation per instruction set.
+ *
+ * Callers go through kernels(), which holds the widest set this machine
+ * runs: on x86 AVX2 or SSE2, chosen once by CPUID; in a WASM module built
+ * with -msimd128, simd128; scalar everywhere else. Every set returns exactly
+ * what the scalar one does, so which one ran never shows in a result.
+ */
+struct KernelSet {
+    const char* name;               // "scalar", "sse2", "avx2", "simd128"
+
+    /**
+     * First p in [pos, size) where a token starts with a digit or capital:
+     * text[p - 1] is whitespace (\s) and text[p] is [0-9A-Z]. Never 0,
+     * which has no character before it. size if there is none.
+     */
+    size_t (*findTokenStart)(const char* text, size_t size, size_t pos);
+
+    /**
+     * First i in [begin, end - 3) where \d[.,]\d\d starts and is not
+     * followed by another digit (text[i + 4], looked at up to size): the
+     * cents of an amount. end if there is none.
+     */
+    size_t (*findCents)(const char* text, size_t size, size_t begin, size_t end);
+};
+
+/**
+ * The set in use
+ */
+const KernelSet& kernels();
+
+/**
+ * Sets this machine can run, narrowest (scalar) first
+ */
+std::vector<const KernelSet*> availableKernelSets();
+
+/**
+ * Use a narrower set than the detected one, e.g. "scalar" to compare
+ * against. Call before starting work. Returns false, changing nothing, if
+ * the set isn't available here.
+ */
+bool selectKernelSet(std::string_view name);
+
+/**
+ * Threads forEachChunk() may use, the caller included. Starts at 1: a
+ * tool that already runs one statement per core leaves it there, one that
+ * has a single large input raises it.
+ */
+size_t kernelThreads();
+void setKernelThreads(size_t threads);
+
+/**
+ * How many chunks to cut count items into: one per kernel thread, but none
+ * smaller than minChunk. At least 1.
+ */
+size_t chunkCount(size_t count, size_t minChunk);
+
+/**
+ * Run fn(chunk) for chunk in [0, chunks), chunk 0 on the calling thread and
+ * the others on threads of their own, and wait for all of them. An exception
+ * from any chunk is rethrown here once every chunk has finished.
+ */
+void forEachChunk(size_t chunks, const std::function<void(size_t chunk)>& fn);
+
+} // namespace BankAnalyzer
@@ -0,0 +1,35 @@
+// AVX2 kernel set (built with -mavx2; used only when CPUID reports AVX2)
+#include "vector_scan.h"
+#include <immintrin.h>
+
+namespace BankAnalyzer {
+
+namespace {
+
+struct Avx2 {
+    using Vec = __m256i;
+    static constexpr size_t kWidth = 32;
+
+    static Vec load(const char* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static Vec splat(char c) { return _mm256_set1_epi8(c); }
+    static Vec eq(Vec a, Vec b) { return _mm256_cmpeq_epi8(a, b); }
+    static Vec greater(Vec a, Vec b) { return _mm256_cmpgt_epi8(a, b); }
+    static Vec both(Vec a, Vec b) { return _mm256_and_si256(a, b); }
+    static Vec either(Vec a, Vec b) { return _mm256_or_si256(a, b); }
+    static Vec butNot(Vec a, Vec b) { return _mm256_andnot_si256(b, a); }
+    static uint32_t mask(Vec v) { return static_cast<uint32_t>(_mm256_movemask_epi8(v)); }
+};
+
+const KernelSet kAvx2Kernels = {
+    "avx2",
+    findTokenStartVector<Avx2>,
+    findCentsVector<Avx2>,
+};
+
+} // namespace
+
+const KernelSet& avx2Kernels() {
+    return kAvx2Kernels;
+}
+
+} // namespace BankAnalyzer
@@ -0,0 +1,38 @@
+// WebAssembly simd128 kernel set, in modules built with -msimd128
+// (TELLER_WASM_VARIANT simd or simd-threads). Empty otherwise.
+#ifdef __wasm_simd128__
+#include "vector_scan.h"
+#include <wasm_simd128.h>
+
+namespace BankAnalyzer {
+
+namespace {
+
+struct Simd128 {
+    using Vec = v128_t;
+    static constexpr size_t kWidth = 16;
+
+    static Vec load(const char* p) { return wasm_v128_load(p); }
+    static Vec splat(char c) { return wasm_i8x16_splat(c); }
+    static Vec eq(Vec a, Vec b) { return wasm_i8x16_eq(a, b); }
+    static Vec greater(Vec a, Vec b) { return wasm_i8x16_gt(a, b); }
+    static Vec both(Vec a, Vec b) { return wasm_v128_and(a, b); }
+    static Vec either(Vec a, Vec b) { return wasm_v128_or(a, b); }
+    static Vec butNot(Vec a, Vec b) { return wasm_v128_andnot(a, b); }
+    static uint32_t mask(Vec v) { return wasm_i8x16_bitmask(v); }
+};
+
+const KernelSet kSimd128Kernels = {
+    "simd128",
+    findTokenStartVector<Simd128>,
+    findCentsVector<Simd128>,
+};
+
+} // namespace
+
+const KernelSet& simd128Kernels() {
+    return kSimd128Kernels;
+}
+
+} // namespace BankAnalyzer
+#endif
@@ -0,0 +1,35 @@
+// SSE2 kernel set (built with -msse2; baseline on x86-64)
+#include "vector_scan.h"
+#include <emmintrin.h>
+
+namespace BankAnalyzer {
+
+namespace {
+
+struct Sse2 {
+    using Vec = __m128i;
+    static constexpr size_t kWidth = 16;
+
+    static Vec load(const char* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static Vec splat(char c) { return _mm_set1_epi8(c); }
+    static Vec eq(Vec a, Vec b) { return _mm_cmpeq_epi8(a, b); }
+    static Vec greater(Vec a, Vec b) { return _mm_cmpgt_epi8(a, b); }
+    static Vec both(Vec a, Vec b) { return _mm_and_si128(a, b); }
+    static Vec either(Vec a, Vec b) { return _mm_or_si128(a, b); }
+    static Vec butNot(Vec a, Vec b) { return _mm_andnot_si128(b, a); }
+    static uint32_t mask(Vec v) { return static_cast<uint32_t>(_mm_movemask_epi8(v)); }
+};
+
+const KernelSet kSse2Kernels = {
+    "sse2",
+    findTokenStartVector<Sse2>,
+    findCentsVector<Sse2>,
+};
+
+} // namespace
+
+const KernelSet& sse2Kernels() {
+    return kSse2Kernels;
+}
+
+} // namespace BankAnalyzer
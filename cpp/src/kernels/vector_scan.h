@@ -0,0 +1,87 @@
+#pragma once
+#include "kernel_sets.h"
+#include <cstdint>
+
+// The byte-class scans, written once over an instruction set's operations.
+// Included only by the kernels_<isa>.cpp files, each of which is built for
+// its own instruction set: everything here is in an anonymous namespace so
+// each file keeps its own copy and the linker can't hand a wider one to a
+// narrower caller.
+//
+// An Isa provides:
+//   Vec, kWidth                       register type and its width in bytes
+//   load(p), splat(c)                 unaligned load, broadcast
+//   eq, greater(a, b)                 per byte, signed compare
+//   both(a, b), either(a, b)          and, or
+//   butNot(a, b)                      a and not b
+//   mask(v)                           top bit of each byte, as bits
+//
+// Bytes of 0x80 and up are negative in a signed compare, so they fail every
+// class below, as in the scalar tests.
+
+namespace BankAnalyzer {
+namespace {
+
+template <typename Isa>
+struct ByteClasses {
+    using Vec = typename Isa::Vec;
+
+    // [0-9]
+    static Vec digit(Vec v) {
+        return Isa::both(Isa::greater(v, Isa::splat('0' - 1)), Isa::greater(Isa::splat('9' + 1), v));
+    }
+
+    // [0-9A-Z]
+    static Vec digitOrCapital(Vec v) {
+        Vec capital = Isa::both(Isa::greater(v, Isa::splat('A' - 1)), Isa::greater(Isa::splat('Z' + 1), v));
+        return Isa::either(capital, digit(v));
+    }
+
+    // \s: space, \t \n \v \f \r
+    static Vec space(Vec v) {
+        Vec control = Isa::both(Isa::greater(v, Isa::splat('\t' - 1)), Isa::greater(Isa::splat('\r' + 1), v));
+        return Isa::either(control, Isa::eq(v, Isa::splat(' ')));
+    }
+};
+
+inline size_t lowestBit(uint32_t bits) {
+    return static_cast<size_t>(__builtin_ctz(bits));
+}
+
+template <typename Isa>
+size_t findTokenStartVector(const char* text, size_t size, size_t pos) {
+    using Classes = ByteClasses<Isa>;
+    size_t p = pos > 0 ? pos : 1;
+    while (p + Isa::kWidth <= size) {
+        auto found = Isa::both(Classes::space(Isa::load(text + p - 1)), Classes::digitOrCapital(Isa::load(text + p)));
+        uint32_t bits = Isa::mask(found);
+        if (bits != 0) {
+            return p + lowestBit(bits);
+        }
+        p += Isa::kWidth;
+    }
+    return findTokenStartScalar(text, size, p);
+}
+
+template <typename Isa>
+size_t findCentsVector(const char* text, size_t size, size_t begin, size_t end) {
+    using Classes = ByteClasses<Isa>;
+    size_t i = begin;
+    // Every lane a candidate (i + lane < end - 3) with its fifth byte in the text
+    while (i + Isa::kWidth + 3 <= end && i + Isa::kWidth + 4 <= size) {
+        auto separator = Isa::load(text + i + 1);
+        auto found = Isa::both(Classes::digit(Isa::load(text + i)),
+                               Isa::either(Isa::eq(separator, Isa::splat('.')), Isa::eq(separator, Isa::splat(','))));
+        found = Isa::both(found, Isa::both(Classes::digit(Isa::load(text + i + 2)), Classes::digit(Isa::load(text + i + 3))));
+        found = Isa::butNot(found, Classes::digit(Isa::load(text + i + 4)));
+        uint32_t bits = Isa::mask(found);
+        if (bits != 0) {
+            return i + lowestBit(bits);
+        }
+        i += Isa::kWidth;
+    }
+    return findCentsScalar(text, size, i, end);
+}
+
+} // namespace
+} // namespace BankAnalyzer
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace BankAnalyzer {
+
+/**
+ * One bit per transaction row, for combining filters with word-wide AND/OR
+ */
+class RowBitmap {
+public:
+    RowBitmap() = default;
+    explicit RowBitmap(size_t rows, bool value = false)
+        : words_((rows + 63) / 64, value ? ~uint64_t(0) : 0), rows_(rows) {
+        clearTail();
+    }
+
+    size_t rows() const { return rows_; }
+
+    bool test(size_t row) const { return (words_[row / 64] >> (row % 64)) & 1; }
+    void set(size_t row) { words_[row / 64] |= uint64_t(1) << (row % 64); }
+    void reset(size_t row) { words_[row / 64] &= ~(uint64_t(1) << (row % 64)); }
+
+    RowBitmap& operator&=(const RowBitmap& other) {
+        for (size_t i = 0; i < words_.size(); ++i) words_[i] &= other.words_[i];
+        return *this;
+    }
+
+    RowBitmap& operator|=(const RowBitmap& other) {
+        for (size_t i = 0; i < words_.size(); ++i) words_[i] |= other.words_[i];
+        return *this;
+    }
+
+    size_t count() const {
+        size_t total = 0;
+        for (uint64_t word : words_) total += popcount(word);
+        return total;
+    }
+
+private:
+    static size_t popcount(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_popcountll(word));
+#else
+        size_t bits = 0;
+        for (; word; word &= word - 1) ++bits;
+        return bits;
+#endif
+    }
+
+    // Bits past the last row stay zero so count() is exact
+    void clearTail() {
+        if (rows_ % 64 != 0 && !words_.empty()) {
+            words_.back() &= (uint64_t(1) << (rows_ % 64)) - 1;
+        }
+    }
+
+    std::vector<uint64_t> words_;
+    size_t rows_ = 0;
+};
+
+} // namespace BankAnalyzer
@@ -0,0 +1,239 @@
+#include "transaction_index.h"
+#include "../analyzer/merchant_normalizer.h"
+#include "../analyzer/statement_dates.h"
+#include <algorithm>
+#include <numeric>
+#include <string_view>
+#include <unordered_map>
+
+namespace BankAnalyzer {
+
+namespace {
+
+constexpr size_t kSortKeyCount = 7;
+
+// Rank of each string in sorted order (equal strings share a rank)
+template <typename Text>
+std::vector<uint32_t> rankStrings(const std::vector<Text>& strings) {
+    std::vector<uint32_t> order(strings.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return std::string_view(strings[a]) < std::string_view(strings[b]);
+    });
+
+    std::vector<uint32_t> ranks(strings.size());
+    uint32_t rank = 0;
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (i > 0 && std::string_view(strings[order[i]]) != std::string_view(strings[order[i - 1]])) {
+            ++rank;
+        }
+        ranks[order[i]] = rank;
+    }
+    return ranks;
+}
+
+// Row permutation ordered by key(row), ties in ledger order either way
+template <typename Key>
+std::vector<uint32_t> sortedRows(size_t count, bool descending, Key key) {
+    std::vector<uint32_t> rows(count);
+    std::iota(rows.begin(), rows.end(), 0);
+    std::stable_sort(rows.begin(), rows.end(), [&](uint32_t a, uint32_t b) {
+        return descending ? key(b) < key(a) : key(a) < key(b);
+    });
+    return rows;
+}
+
+size_t permutationSlot(SortKey key, bool descending) {
+    return static_cast<size_t>(key) * 2 + (descending ? 1 : 0);
+}
+
+} // namespace
+
+void TransactionIndex::build(const std::vector<Transaction>& transactions) {
+    transactions_ = &transactions;
+    size_t n = transactions.size();
+
+    // Distinct descriptions, each indexed once
+    std::unordered_map<std::string_view, uint32_t> descriptionIds;
+    std::vector<std::string_view> distinct;
+    descriptionIds_.resize(n);
+    descriptionRows_.clear();
+    for (size_t row = 0; row < n; ++row) {
+        auto inserted = descriptionIds.emplace(transactions[row].description,
+                                               static_cast<uint32_t>(distinct.size()));
+        if (inserted.second) {
+            distinct.push_back(transactions[row].description);
+            descriptionRows_.emplace_back();
+        }
+        descriptionIds_[row] = inserted.first->second;
+        descriptionRows_[inserted.first->second].push_back(static_cast<uint32_t>(row));
+    }
+    descriptions_.build(distinct);
+
+    credit_ = RowBitmap(n);
+    debit_ = RowBitmap(n);
+    categoryIds_.resize(n);
+    categoryNames_.clear();
+    categoryBitmaps_.clear();
+    for (size_t row = 0; row < n; ++row) {
+        if (transactions[row].type == "credit") {
+            credit_.set(row);
+        } else if (transactions[row].type == "debit") {
+            debit_.set(row);
+        }
+        uint32_t category = categoryId(transactions[row].category);
+        categoryIds_[row] = category;
+        categoryBitmaps_[category].set(row);
+    }
+
+    // Unreadable dates sort after every real one
+    days_ = resolveTransactionDays(transactions).days;
+    for (int64_t& day : days_) {
+        if (day == kUnknownDay) day = INT64_MAX;
+    }
+
+    merchants_.clear();
+    permutations_.assign(kSortKeyCount * 2, std::vector<uint32_t>());
+}
+
+uint32_t TransactionIndex::categoryId(const std::string& category) {
+    for (size_t i = 0; i < categoryNames_.size(); ++i) {
+        if (categoryNames_[i] == category) {
+            return static_cast<uint32_t>(i);
+        }
+    }
+    categoryNames_.push_back(category);
+    categoryBitmaps_.emplace_back(size());
+    return static_cast<uint32_t>(categoryNames_.size() - 1);
+}
+
+const std::vector<uint32_t>& TransactionIndex::permutation(SortKey key, bool descending) {
+    std::vector<uint32_t>& rows = permutations_[permutationSlot(key, descending)];
+    if (!rows.empty() || size() == 0) {
+        return rows;
+    }
+
+    const std::vector<Transaction>& ledger = *transactions_;
+    switch (key) {
+    case SortKey::Date:
+        rows = sortedRows(size(), descending, [&](uint32_t row) { return days_[row]; });
+        break;
+    case SortKey::Description: {
+        std::vector<std::string_view> distinct(descriptionRows_.size());
+        for (size_t id = 0; id < distinct.size(); ++id) {
+            distinct[id] = ledger[descriptionRows_[id].front()].description;
+        }
+        std::vector<uint32_t> ranks = rankStrings(distinct);
+        rows = sortedRows(size(), descending, [&](uint32_t row) { return ranks[descriptionIds_[row]]; });
+        break;
+    }
+    case SortKey::Category: {
+        std::vector<uint32_t> ranks = rankStrings(categoryNames_);
+        rows = sortedRows(size(), descending, [&](uint32_t row) { return ranks[categoryIds_[row]]; });
+        break;
+    }
+    case SortKey::Merchant: {
+        if (merchants_.empty()) {
+            merchants_.reserve(descriptionRows_.size());
+            for (const auto& members : descriptionRows_) {
+                merchants_.push_back(normalizeMerchant(ledger[members.front()].description));
+            }
+        }
+        std::vector<uint32_t> ranks = rankStrings(merchants_);
+        rows = sortedRows(size(), descending, [&](uint32_t row) { return ranks[descriptionIds_[row]]; });
+        break;
+    }
+    case SortKey::Type:
+        rows = sortedRows(size(), descending, [&](uint32_t row) { return std::string_view(ledger[row].type); });
+        break;
+    case SortKey::Amount:
+        rows = sortedRows(size(), descending, [&](uint32_t row) { return ledger[row].amount.minor; });
+        break;
+    case SortKey::Balance:
+        rows = sortedRows(size(), descending, [&](uint32_t row) { return ledger[row].balance.minor; });
+        break;
+    }
+    return rows;
+}
+
+RowBitmap TransactionIndex::searchBitmap(const std::string& text) const {
+    RowBitmap matches(size());
+    for (uint32_t id : descriptions_.search(text)) {
+        for (uint32_t row : descriptionRows_[id]) {
+            matches.set(row);
+        }
+    }
+    return matches;
+}
+
+QueryResult TransactionIndex::query(const TransactionQuery& request) {
+    QueryResult result;
+    size_t n = size();
+
+    // Filters as bitmaps; no filter at all leaves every row in
+    bool filtered = false;
+    RowBitmap filter;
+    auto narrow = [&](const RowBitmap& bitmap) {
+        if (filtered) {
+            filter &= bitmap;
+        } else {
+            filter = bitmap;
+            filtered = true;
+        }
+    };
+    if (!request.type.empty()) {
+        narrow(request.type == "credit" ? credit_ : request.type == "debit" ? debit_ : RowBitmap(n));
+    }
+    if (!request.categories.empty()) {
+        RowBitmap any(n);
+        for (const std::string& category : request.categories) {
+            auto found = std::find(categoryNames_.begin(), categoryNames_.end(), category);
+            if (found != categoryNames_.end()) {
+                any |= categoryBitmaps_[found - categoryNames_.begin()];
+            }
+        }
+        narrow(any);
+    }
+    if (!request.text.empty()) {
+        narrow(searchBitmap(request.text));
+    }
+    result.total = filtered ? filter.count() : n;
+
+    // Walk the permutation until the page is full
+    size_t end = request.limit == 0 ? result.total : std::min(result.total, request.offset + request.limit);
+    if (request.offset >= end) {
+        return result;
+    }
+    result.rows.reserve(end - request.offset);
+    const std::vector<uint32_t>& order = permutation(request.sort, request.descending);
+    size_t position = 0;
+    for (size_t i = 0; i < n && position < end; ++i) {
+        uint32_t row = order[i];
+        if (filtered && !filter.test(row)) {
+            continue;
+        }
+        if (position >= request.offset) {
+            result.rows.push_back(row);
+        }
+        ++position;
+    }
+    return result;
+}
+
+void TransactionIndex::setCategory(size_t row, const std::string& category) {
+    if (row >= size()) {
+        return;
+    }
+    uint32_t previous = categoryIds_[row];
+    uint32_t next = categoryId(category);
+    if (previous == next) {
+        return;
+    }
+    categoryBitmaps_[previous].reset(row);
+    categoryBitmaps_[next].set(row);
+    categoryIds_[row] = next;
+    permutations_[permutationSlot(SortKey::Category, false)].clear();
+    permutations_[permutationSlot(SortKey::Category, true)].clear();
+}
+
+} // namespace BankAnalyzer
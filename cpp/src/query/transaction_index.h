@@ -0,0 +1,92 @@
+#pragma once
+#include "../extractor/transaction_extractor.h"
+#include "row_bitmap.h"
+#include "trigram_index.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace BankAnalyzer {
+
+enum class SortKey {
+    Date,
+    Description,
+    Category,
+    Merchant,
+    Type,
+    Amount,
+    Balance
+};
+
+/**
+ * Search, filter, sort and page request. Empty fields don't filter.
+ */
+struct TransactionQuery {
+    std::string text;                       // Description substring, any case
+    std::string type;                       // "debit" or "credit"
+    std::vector<std::string> categories;    // Any of these
+    SortKey sort = SortKey::Date;
+    bool descending = false;
+    size_t offset = 0;                      // First matching row to return, in sort order
+    size_t limit = 100;                     // 0 = all
+};
+
+struct QueryResult {
+    size_t total = 0;                       // Rows matching the filters
+    std::vector<uint32_t> rows;             // The requested page, as row ids
+};
+
+/**
+ * Query index over a resident ledger, so search and sort don't touch every
+ * transaction per keystroke.
+ *
+ * - Descriptions are deduplicated and indexed by trigram (TrigramIndex); a
+ *   search resolves to description ids and then to rows.
+ * - Type and category filters are precomputed row bitmaps, ANDed together.
+ * - Each sort key and direction has a row permutation, built the first time
+ *   it is asked for and kept until the ledger changes. Equal keys stay in
+ *   ledger order in both directions. Dates sort by the resolved day
+ *   (statement_dates.h), merchants by normalizeMerchant().
+ * A query is then one pass over the permutation, testing a bit per row.
+ *
+ * The index keeps a pointer to the ledger, which must stay alive and
+ * unchanged; category edits go through setCategory().
+ */
+class TransactionIndex {
+public:
+    void build(const std::vector<Transaction>& transactions);
+
+    QueryResult query(const TransactionQuery& request);
+
+    /**
+     * Recategorize a row (user correction), keeping the category bitmaps and
+     * sort order current
+     */
+    void setCategory(size_t row, const std::string& category);
+
+    size_t size() const { return transactions_ ? transactions_->size() : 0; }
+
+private:
+    const std::vector<uint32_t>& permutation(SortKey key, bool descending);
+    uint32_t categoryId(const std::string& category);
+    RowBitmap searchBitmap(const std::string& text) const;
+
+    const std::vector<Transaction>* transactions_ = nullptr;
+
+    std::vector<uint32_t> descriptionIds_;              // Per row
+    std::vector<std::vector<uint32_t>> descriptionRows_; // Per description id
+    TrigramIndex descriptions_;
+
+    RowBitmap credit_;
+    RowBitmap debit_;
+    std::vector<uint32_t> categoryIds_;                 // Per row, into categoryNames_
+    std::vector<std::string> categoryNames_;
+    std::vector<RowBitmap> categoryBitmaps_;
+
+    std::vector<int64_t> days_;                         // Resolved date per row
+    std::vector<std::string> merchants_;                // Per description id
+    std::vector<std::vector<uint32_t>> permutations_;   // Per SortKey and direction, empty until first use
+};
+
+} // namespace BankAnalyzer
@@ -0,0 +1,105 @@
+#include "trigram_index.h"
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace BankAnalyzer {
+
+namespace {
+
+char lowerAscii(char c) {
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+std::string lowered(std::string_view text) {
+    std::string out(text);
+    for (char& c : out) c = lowerAscii(c);
+    return out;
+}
+
+uint32_t trigramAt(std::string_view text, size_t pos) {
+    return (static_cast<uint32_t>(static_cast<unsigned char>(text[pos])) << 16) |
+           (static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 1])) << 8) |
+           static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 2]));
+}
+
+} // namespace
+
+void TrigramIndex::build(const std::vector<std::string_view>& strings) {
+    lowered_.clear();
+    lowered_.reserve(strings.size());
+
+    // (trigram, id) pairs, sorted and deduplicated into posting lists
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+    for (size_t id = 0; id < strings.size(); ++id) {
+        lowered_.push_back(lowered(strings[id]));
+        const std::string& text = lowered_.back();
+        for (size_t pos = 0; pos + 3 <= text.size(); ++pos) {
+            pairs.emplace_back(trigramAt(text, pos), static_cast<uint32_t>(id));
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+    keys_.clear();
+    offsets_.clear();
+    postings_.clear();
+    postings_.reserve(pairs.size());
+    for (const auto& entry : pairs) {
+        if (keys_.empty() || keys_.back() != entry.first) {
+            keys_.push_back(entry.first);
+            offsets_.push_back(static_cast<uint32_t>(postings_.size()));
+        }
+        postings_.push_back(entry.second);
+    }
+    offsets_.push_back(static_cast<uint32_t>(postings_.size()));
+}
+
+std::vector<uint32_t> TrigramIndex::search(std::string_view needle) const {
+    std::string query = lowered(needle);
+    std::vector<uint32_t> matches;
+
+    if (query.size() < 3) {
+        for (size_t id = 0; id < lowered_.size(); ++id) {
+            if (lowered_[id].find(query) != std::string::npos) {
+                matches.push_back(static_cast<uint32_t>(id));
+            }
+        }
+        return matches;
+    }
+
+    // Posting list per distinct query trigram; any missing trigram means no match
+    std::vector<std::pair<const uint32_t*, const uint32_t*>> lists;
+    for (size_t pos = 0; pos + 3 <= query.size(); ++pos) {
+        uint32_t key = trigramAt(query, pos);
+        auto found = std::lower_bound(keys_.begin(), keys_.end(), key);
+        if (found == keys_.end() || *found != key) {
+            return matches;
+        }
+        size_t k = static_cast<size_t>(found - keys_.begin());
+        lists.emplace_back(postings_.data() + offsets_[k], postings_.data() + offsets_[k + 1]);
+    }
+    std::sort(lists.begin(), lists.end(), [](const auto& a, const auto& b) {
+        return a.second - a.first < b.second - b.first;
+    });
+    lists.erase(std::unique(lists.begin(), lists.end()), lists.end());
+
+    std::vector<uint32_t> candidates(lists[0].first, lists[0].second);
+    std::vector<uint32_t> next;
+    for (size_t i = 1; i < lists.size() && !candidates.empty(); ++i) {
+        next.clear();
+        std::set_intersection(candidates.begin(), candidates.end(), lists[i].first, lists[i].second,
+                              std::back_inserter(next));
+        candidates.swap(next);
+    }
+
+    // Trigrams can all be present without being adjacent
+    for (uint32_t id : candidates) {
+        if (query.size() == 3 || lowered_[id].find(query) != std::string::npos) {
+            matches.push_back(id);
+        }
+    }
+    return matches;
+}
+
+} // namespace BankAnalyzer
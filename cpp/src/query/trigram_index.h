@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace BankAnalyzer {
+
+/**
+ * Case-insensitive substring search over a set of strings (the distinct
+ * descriptions of a ledger).
+ *
+ * Every ASCII-lowercased string is split into overlapping 3-byte trigrams;
+ * each trigram maps to the sorted list of strings containing it. A query
+ * intersects the lists of its own trigrams, rarest first, and confirms the
+ * survivors with a real substring check. Queries shorter than three bytes
+ * fall back to scanning the strings.
+ */
+class TrigramIndex {
+public:
+    /**
+     * Index the strings; ids are their positions in the vector
+     */
+    void build(const std::vector<std::string_view>& strings);
+
+    /**
+     * Ids of the strings containing needle (ignoring ASCII case), ascending
+     */
+    std::vector<uint32_t> search(std::string_view needle) const;
+
+    size_t size() const { return lowered_.size(); }
+
+private:
+    std::vector<std::string> lowered_;
+    std::vector<uint32_t> keys_;        // Sorted distinct trigrams
+    std::vector<uint32_t> offsets_;     // postings_[offsets_[k], offsets_[k + 1]) for keys_[k]
+    std::vector<uint32_t> postings_;    // String ids, ascending within each trigram
+};
+
+} // namespace BankAnalyzer
@@ -0,0 +1,561 @@
+#include "snapshot.h"
+#include "../analyzer/merchant_normalizer.h"
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace BankAnalyzer {
+
+namespace {
+
+constexpr uint32_t kMagic = 0x4E534C54;     // "TLSN"
+constexpr size_t kHeaderSize = 64;
+constexpr size_t kCategoryEntrySize = 16;   // name id, has total, total
+constexpr size_t kMerchantEntrySize = 4;    // name id
+constexpr size_t kAggregatesSize = 32;      // income, expenses, net change, currency
+constexpr size_t kSeriesRecordSize = 88;
+constexpr size_t kTransferRecordSize = 32;   // debit, credit, currency, amount, day gap
+
+constexpr uint8_t kFlagCredit = 1;
+constexpr uint8_t kFlagHasBalance = 2;
+constexpr uint8_t kFlagBalanceMismatch = 4;
+
+struct Counts {
+    uint32_t transactions = 0;
+    uint32_t strings = 0;
+    uint32_t stringBytes = 0;
+    uint32_t categories = 0;
+    uint32_t merchants = 0;
+    uint32_t series = 0;
+    uint32_t seriesIndices = 0;
+    uint32_t transfers = 0;
+};
+
+// Section offsets, shared by the writer and the reader
+using Layout = SnapshotView::Sections;
+
+uint64_t align8(uint64_t offset) {
+    return (offset + 7) & ~static_cast<uint64_t>(7);
+}
+
+// Sections for these counts, if they end within limit bytes. Offsets are
+// summed in 64 bits: a reader's counts come from the file, and size_t sums of
+// them could wrap on wasm32 and pass the size check.
+bool computeLayout(const Counts& counts, uint64_t limit, Layout& out) {
+    uint64_t n = counts.transactions;
+    Layout layout;
+    uint64_t offset = kHeaderSize;
+    auto section = [&](uint64_t bytes) {
+        uint64_t start = offset;
+        offset = align8(offset + bytes);
+        return static_cast<size_t>(start);
+    };
+    layout.amount = section(n * 8);
+    layout.balance = section(n * 8);
+    layout.currency = section(n * 4);
+    layout.date = section(n * 4);
+    layout.description = section(n * 4);
+    layout.account = section(n * 4);
+    layout.category = section(n * 4);
+    layout.merchant = section(n * 4);
+    layout.flags = section(n);
+    layout.categories = section(uint64_t{counts.categories} * kCategoryEntrySize);
+    layout.merchants = section(uint64_t{counts.merchants} * kMerchantEntrySize);
+    layout.aggregates = section(kAggregatesSize);
+    layout.series = section(uint64_t{counts.series} * kSeriesRecordSize);
+    layout.seriesIndices = section(uint64_t{counts.seriesIndices} * 4);
+    layout.transfers = section(uint64_t{counts.transfers} * kTransferRecordSize);
+    layout.stringOffsets = section((uint64_t{counts.strings} + 1) * 4);
+    layout.stringBytes = section(counts.stringBytes);
+    if (offset > limit) {
+        return false;
+    }
+    layout.end = static_cast<size_t>(offset);
+    out = layout;
+    return true;
+}
+
+template <typename T>
+void store(std::string& out, size_t offset, T value) {
+    std::memcpy(&out[offset], &value, sizeof(T));
+}
+
+template <typename T>
+T load(const char* data, size_t offset) {
+    T value;
+    std::memcpy(&value, data + offset, sizeof(T));
+    return value;
+}
+
+// Distinct strings in first-seen order; the views must outlive the pool
+class StringPool {
+public:
+    uint32_t intern(std::string_view text) {
+        auto found = ids_.find(text);
+        if (found != ids_.end()) {
+            return found->second;
+        }
+        uint32_t id = static_cast<uint32_t>(strings_.size());
+        ids_.emplace(text, id);
+        strings_.push_back(text);
+        bytes_ += text.size();
+        return id;
+    }
+
+    const std::vector<std::string_view>& strings() const { return strings_; }
+    size_t bytes() const { return bytes_; }
+
+private:
+    std::unordered_map<std::string_view, uint32_t> ids_;
+    std::vector<std::string_view> strings_;
+    size_t bytes_ = 0;
+};
+
+// Table of distinct names (categories, merchants) with their string ids
+class NameTable {
+public:
+    uint32_t add(std::string_view name, StringPool& pool) {
+        auto found = indices_.find(name);
+        if (found != indices_.end()) {
+            return found->second;
+        }
+        uint32_t index = static_cast<uint32_t>(nameIds_.size());
+        indices_.emplace(name, index);
+        nameIds_.push_back(pool.intern(name));
+        return index;
+    }
+
+    const std::vector<uint32_t>& nameIds() const { return nameIds_; }
+
+private:
+    std::unordered_map<std::string_view, uint32_t> indices_;
+    std::vector<uint32_t> nameIds_;
+};
+
+} // namespace
+
+uint64_t hashStatementText(std::string_view text) {
+    constexpr uint64_t kMultiplier = 0x9E3779B97F4A7C15ull;
+    constexpr uint64_t kMixer = 0xBF58476D1CE4E5B9ull;
+    auto mixWord = [&](uint64_t hash, uint64_t word) {
+        hash ^= word * kMultiplier;
+        hash = (hash << 29) | (hash >> 35);
+        return hash * kMixer;
+    };
+
+    uint64_t hash = 0x243F6A8885A308D3ull ^ (static_cast<uint64_t>(text.size()) * kMultiplier);
+    size_t i = 0;
+    for (; i + 8 <= text.size(); i += 8) {
+        hash = mixWord(hash, load<uint64_t>(text.data(), i));
+    }
+    if (i < text.size()) {
+        uint64_t tail = 0;
+        std::memcpy(&tail, text.data() + i, text.size() - i);
+        hash = mixWord(hash, tail);
+    }
+
+    // Final avalanche (splitmix64)
+    hash ^= hash >> 30;
+    hash *= kMixer;
+    hash ^= hash >> 27;
+    hash *= 0x94D049BB133111EBull;
+    hash ^= hash >> 31;
+    return hash;
+}
+
+std::string formatSnapshotKey(uint64_t hash) {
+    static const char kDigits[] = "0123456789abcdef";
+    std::string key(16, '0');
+    for (int i = 15; i >= 0; --i) {
+        key[i] = kDigits[hash & 0xF];
+        hash >>= 4;
+    }
+    return key;
+}
+
+std::string buildSnapshot(const std::vector<Transaction>& transactions, const AnalysisResult& analysis,
+                          uint64_t sourceHash) {
+    StringPool pool;
+    NameTable categories;
+    NameTable merchants;
+
+    // Each distinct description is normalized once; the merchant strings
+    // live in a deque so the pool's views stay valid
+    std::deque<std::string> merchantNames;
+    std::unordered_map<std::string_view, uint32_t> descriptionMerchants;
+
+    size_t n = transactions.size();
+    std::vector<uint32_t> dateIds(n), descriptionIds(n), accountIds(n), categoryIndices(n), merchantIndices(n);
+    for (size_t i = 0; i < n; ++i) {
+        const Transaction& txn = transactions[i];
+        dateIds[i] = pool.intern(txn.date);
+        descriptionIds[i] = pool.intern(txn.description);
+        accountIds[i] = pool.intern(txn.account);
+        categoryIndices[i] = categories.add(txn.category, pool);
+
+        auto found = descriptionMerchants.find(txn.description);
+        if (found == descriptionMerchants.end()) {
+            merchantNames.push_back(normalizeMerchant(txn.description));
+            uint32_t index = merchants.add(merchantNames.back(), pool);
+            found = descriptionMerchants.emplace(txn.description, index).first;
+        }
+        merchantIndices[i] = found->second;
+    }
+    for (const auto& entry : analysis.categoryTotals) {
+        categories.add(entry.first, pool);
+    }
+
+    // Recurring series strings and member indices
+    std::vector<uint32_t> seriesIndices;
+    std::vector<uint32_t> seriesStrings;    // 7 per series, in record order
+    for (const RecurringSeries& series : analysis.recurring) {
+        for (const std::string* text : {&series.merchant, &series.description, &series.cadence, &series.type,
+                                        &series.firstDate, &series.lastDate, &series.nextDate}) {
+            seriesStrings.push_back(pool.intern(*text));
+        }
+        for (size_t index : series.transactions) {
+            seriesIndices.push_back(static_cast<uint32_t>(index));
+        }
+    }
+
+    Counts counts;
+    counts.transactions = static_cast<uint32_t>(n);
+    counts.strings = static_cast<uint32_t>(pool.strings().size());
+    counts.stringBytes = static_cast<uint32_t>(pool.bytes());
+    counts.categories = static_cast<uint32_t>(categories.nameIds().size());
+    counts.merchants = static_cast<uint32_t>(merchants.nameIds().size());
+    counts.series = static_cast<uint32_t>(analysis.recurring.size());
+    counts.seriesIndices = static_cast<uint32_t>(seriesIndices.size());
+    counts.transfers = static_cast<uint32_t>(analysis.transfers.size());
+    Layout layout;
+    if (!computeLayout(counts, UINT32_MAX, layout)) {
+        throw std::length_error("snapshot would exceed 4 GB");
+    }
+
+    std::string out(layout.end, '\0');
+    store<uint32_t>(out, 0, kMagic);
+    store<uint16_t>(out, 4, kSnapshotVersion);
+    store<uint16_t>(out, 6, static_cast<uint16_t>(kHeaderSize));
+    store<uint64_t>(out, 8, sourceHash);
+    store<uint32_t>(out, 16, static_cast<uint32_t>(layout.end));
+    store<uint32_t>(out, 20, counts.transactions);
+    store<uint32_t>(out, 24, counts.strings);
+    store<uint32_t>(out, 28, counts.stringBytes);
+    store<uint32_t>(out, 32, counts.categories);
+    store<uint32_t>(out, 36, counts.merchants);
+    store<uint32_t>(out, 40, counts.series);
+    store<uint32_t>(out, 44, counts.seriesIndices);
+    store<uint32_t>(out, 48, counts.transfers);
+
+    for (size_t i = 0; i < n; ++i) {
+        const Transaction& txn = transactions[i];
+        store<int64_t>(out, layout.amount + i * 8, txn.amount.minor);
+        store<int64_t>(out, layout.balance + i * 8, txn.balance.minor);
+        store<uint32_t>(out, layout.currency + i * 4, txn.amount.currency);
+        store<uint32_t>(out, layout.date + i * 4, dateIds[i]);
+        store<uint32_t>(out, layout.description + i * 4, descriptionIds[i]);
+        store<uint32_t>(out, layout.account + i * 4, accountIds[i]);
+        store<uint32_t>(out, layout.category + i * 4, categoryIndices[i]);
+        store<uint32_t>(out, layout.merchant + i * 4, merchantIndices[i]);
+        uint8_t flags = (txn.type == "credit" ? kFlagCredit : 0) |
+                        (txn.hasBalance ? kFlagHasBalance : 0) |
+                        (txn.balanceMismatch ? kFlagBalanceMismatch : 0);
+        store<uint8_t>(out, layout.flags + i, flags);
+    }
+
+    const std::vector<uint32_t>& categoryIds = categories.nameIds();
+    for (size_t i = 0; i < categoryIds.size(); ++i) {
+        size_t entry = layout.categories + i * kCategoryEntrySize;
+        auto total = analysis.categoryTotals.find(std::string(pool.strings()[categoryIds[i]]));
+        store<uint32_t>(out, entry, categoryIds[i]);
+        store<uint32_t>(out, entry + 4, total != analysis.categoryTotals.end() ? 1 : 0);
+        store<int64_t>(out, entry + 8, total != analysis.categoryTotals.end() ? total->second.minor : 0);
+    }
+    const std::vector<uint32_t>& merchantIds = merchants.nameIds();
+    for (size_t i = 0; i < merchantIds.size(); ++i) {
+        store<uint32_t>(out, layout.merchants + i * kMerchantEntrySize, merchantIds[i]);
+    }
+
+    store<int64_t>(out, layout.aggregates, analysis.totalIncome.minor);
+    store<int64_t>(out, layout.aggregates + 8, analysis.totalExpenses.minor);
+    store<int64_t>(out, layout.aggregates + 16, analysis.netChange.minor);
+    store<uint32_t>(out, layout.aggregates + 24, analysis.totalIncome.currency);
+
+    uint32_t indexBegin = 0;
+    for (size_t i = 0; i < analysis.recurring.size(); ++i) {
+        const RecurringSeries& series = analysis.recurring[i];
+        size_t record = layout.series + i * kSeriesRecordSize;
+        for (size_t s = 0; s < 7; ++s) {
+            store<uint32_t>(out, record + s * 4, seriesStrings[i * 7 + s]);
+        }
+        store<uint32_t>(out, record + 28, static_cast<uint32_t>(series.occurrences));
+        store<uint32_t>(out, record + 32, indexBegin);
+        store<uint32_t>(out, record + 36, static_cast<uint32_t>(series.transactions.size()));
+        store<uint32_t>(out, record + 40, series.active ? 1 : 0);
+        store<uint32_t>(out, record + 44, series.lastAmount.currency);
+        store<int64_t>(out, record + 48, series.averageAmount.minor);
+        store<int64_t>(out, record + 56, series.lastAmount.minor);
+        store<double>(out, record + 64, series.intervalDays);
+        store<double>(out, record + 72, series.confidence);
+        store<int64_t>(out, record + 80, series.nextAmount.minor);
+        indexBegin += static_cast<uint32_t>(series.transactions.size());
+    }
+    for (size_t i = 0; i < seriesIndices.size(); ++i) {
+        store<uint32_t>(out, layout.seriesIndices + i * 4, seriesIndices[i]);
+    }
+    for (size_t i = 0; i < analysis.transfers.size(); ++i) {
+        const TransferPair& pair = analysis.transfers[i];
+        size_t record = layout.transfers + i * kTransferRecordSize;
+        store<uint32_t>(out, record, static_cast<uint32_t>(pair.debit));
+        store<uint32_t>(out, record + 4, static_cast<uint32_t>(pair.credit));
+        store<uint32_t>(out, record + 8, pair.amount.currency);
+        store<int64_t>(out, record + 16, pair.amount.minor);
+        store<int64_t>(out, record + 24, pair.dayGap);
+    }
+
+    uint32_t stringOffset = 0;
+    const std::vector<std::string_view>& strings = pool.strings();
+    for (size_t i = 0; i < strings.size(); ++i) {
+        store<uint32_t>(out, layout.stringOffsets + i * 4, stringOffset);
+        if (!strings[i].empty()) {
+            std::memcpy(&out[layout.stringBytes + stringOffset], strings[i].data(), strings[i].size());
+        }
+        stringOffset += static_cast<uint32_t>(strings[i].size());
+    }
+    store<uint32_t>(out, layout.stringOffsets + strings.size() * 4, stringOffset);
+
+    return out;
+}
+
+bool SnapshotView::open(std::string_view bytes, std::string& error) {
+    *this = SnapshotView();
+    if (bytes.size() < kHeaderSize) {
+        error = "snapshot is truncated";
+        return false;
+    }
+    const char* data = bytes.data();
+    if (load<uint32_t>(data, 0) != kMagic) {
+        error = "not a snapshot";
+        return false;
+    }
+    if (load<uint16_t>(data, 4) != kSnapshotVersion || load<uint16_t>(data, 6) != kHeaderSize) {
+        error = "snapshot version " + std::to_string(load<uint16_t>(data, 4)) + " is not supported";
+        return false;
+    }
+
+    Counts counts;
+    counts.transactions = load<uint32_t>(data, 20);
+    counts.strings = load<uint32_t>(data, 24);
+    counts.stringBytes = load<uint32_t>(data, 28);
+    counts.categories = load<uint32_t>(data, 32);
+    counts.merchants = load<uint32_t>(data, 36);
+    counts.series = load<uint32_t>(data, 40);
+    counts.seriesIndices = load<uint32_t>(data, 44);
+    counts.transfers = load<uint32_t>(data, 48);
+    Layout layout;
+    if (!computeLayout(counts, bytes.size(), layout) || load<uint32_t>(data, 16) != layout.end) {
+        error = "snapshot is truncated";
+        return false;
+    }
+
+    // Everything the accessors index must be in range, so they can skip the checks
+    auto corrupt = [&] {
+        error = "snapshot is corrupt";
+        return false;
+    };
+    uint32_t previous = 0;
+    for (size_t i = 0; i <= counts.strings; ++i) {
+        uint32_t offset = load<uint32_t>(data, layout.stringOffsets + i * 4);
+        if (offset < previous || (i == 0 && offset != 0)) return corrupt();
+        previous = offset;
+    }
+    if (previous != counts.stringBytes) return corrupt();
+
+    for (size_t i = 0; i < counts.transactions; ++i) {
+        if (load<uint32_t>(data, layout.date + i * 4) >= counts.strings ||
+            load<uint32_t>(data, layout.description + i * 4) >= counts.strings ||
+            load<uint32_t>(data, layout.account + i * 4) >= counts.strings ||
+            load<uint32_t>(data, layout.category + i * 4) >= counts.categories ||
+            load<uint32_t>(data, layout.merchant + i * 4) >= counts.merchants) {
+            return corrupt();
+        }
+    }
+    for (size_t i = 0; i < counts.categories; ++i) {
+        if (load<uint32_t>(data, layout.categories + i * kCategoryEntrySize) >= counts.strings) return corrupt();
+    }
+    for (size_t i = 0; i < counts.merchants; ++i) {
+        if (load<uint32_t>(data, layout.merchants + i * kMerchantEntrySize) >= counts.strings) return corrupt();
+    }
+    for (size_t i = 0; i < counts.series; ++i) {
+        size_t record = layout.series + i * kSeriesRecordSize;
+        for (size_t s = 0; s < 7; ++s) {
+            if (load<uint32_t>(data, record + s * 4) >= counts.strings) return corrupt();
+        }
+        uint64_t begin = load<uint32_t>(data, record + 32);
+        uint64_t length = load<uint32_t>(data, record + 36);
+        if (begin + length > counts.seriesIndices) return corrupt();
+    }
+    for (size_t i = 0; i < counts.seriesIndices; ++i) {
+        if (load<uint32_t>(data, layout.seriesIndices + i * 4) >= counts.transactions) return corrupt();
+    }
+    for (size_t i = 0; i < counts.transfers; ++i) {
+        size_t record = layout.transfers + i * kTransferRecordSize;
+        if (load<uint32_t>(data, record) >= counts.transactions ||
+            load<uint32_t>(data, record + 4) >= counts.transactions) {
+            return corrupt();
+        }
+    }
+
+    data_ = data;
+    sections_ = layout;
+    sourceHash_ = load<uint64_t>(data, 8);
+    count_ = counts.transactions;
+    categoryCount_ = counts.categories;
+    merchantCount_ = counts.merchants;
+    seriesCount_ = counts.series;
+    transferCount_ = counts.transfers;
+    return true;
+}
+
+std::string_view SnapshotView::string(uint32_t id) const {
+    const Layout& layout = sections_;
+    uint32_t begin = load<uint32_t>(data_, layout.stringOffsets + id * 4);
+    uint32_t end = load<uint32_t>(data_, layout.stringOffsets + (id + 1) * 4);
+    return std::string_view(data_ + layout.stringBytes + begin, end - begin);
+}
+
+uint8_t SnapshotView::flags(size_t row) const {
+    return load<uint8_t>(data_, sections_.flags + row);
+}
+
+std::string_view SnapshotView::date(size_t row) const {
+    return string(load<uint32_t>(data_, sections_.date + row * 4));
+}
+
+std::string_view SnapshotView::description(size_t row) const {
+    return string(load<uint32_t>(data_, sections_.description + row * 4));
+}
+
+uint32_t SnapshotView::categoryIndex(size_t row) const {
+    return load<uint32_t>(data_, sections_.category + row * 4);
+}
+
+uint32_t SnapshotView::merchantIndex(size_t row) const {
+    return load<uint32_t>(data_, sections_.merchant + row * 4);
+}
+
+std::string_view SnapshotView::account(size_t row) const {
+    return string(load<uint32_t>(data_, sections_.account + row * 4));
+}
+
+std::string_view SnapshotView::category(size_t row) const {
+    return categoryName(categoryIndex(row));
+}
+
+std::string_view SnapshotView::merchant(size_t row) const {
+    return merchantName(merchantIndex(row));
+}
+
+Money SnapshotView::amount(size_t row) const {
+    return Money(load<int64_t>(data_, sections_.amount + row * 8), load<uint32_t>(data_, sections_.currency + row * 4));
+}
+
+Money SnapshotView::balance(size_t row) const {
+    return Money(load<int64_t>(data_, sections_.balance + row * 8), load<uint32_t>(data_, sections_.currency + row * 4));
+}
+
+bool SnapshotView::isCredit(size_t row) const {
+    return flags(row) & kFlagCredit;
+}
+
+std::string_view SnapshotView::categoryName(size_t index) const {
+    return string(load<uint32_t>(data_, sections_.categories + index * kCategoryEntrySize));
+}
+
+std::string_view SnapshotView::merchantName(size_t index) const {
+    return string(load<uint32_t>(data_, sections_.merchants + index * kMerchantEntrySize));
+}
+
+Transaction SnapshotView::transaction(size_t row) const {
+    Transaction txn;
+    uint8_t rowFlags = flags(row);
+    txn.date = std::string(date(row));
+    txn.description = std::string(description(row));
+    txn.account = std::string(account(row));
+    txn.amount = amount(row);
+    txn.balance = balance(row);
+    txn.type = rowFlags & kFlagCredit ? "credit" : "debit";
+    txn.category = std::string(category(row));
+    txn.hasBalance = rowFlags & kFlagHasBalance;
+    txn.balanceMismatch = rowFlags & kFlagBalanceMismatch;
+    return txn;
+}
+
+std::vector<Transaction> SnapshotView::transactions() const {
+    std::vector<Transaction> out;
+    out.reserve(count_);
+    for (size_t row = 0; row < count_; ++row) {
+        out.push_back(transaction(row));
+    }
+    return out;
+}
+
+AnalysisResult SnapshotView::analysis() const {
+    const Layout& layout = sections_;
+    AnalysisResult result;
+    CurrencyCode currency = load<uint32_t>(data_, layout.aggregates + 24);
+    result.totalIncome = Money(load<int64_t>(data_, layout.aggregates), currency);
+    result.totalExpenses = Money(load<int64_t>(data_, layout.aggregates + 8), currency);
+    result.netChange = Money(load<int64_t>(data_, layout.aggregates + 16), currency);
+
+    for (size_t i = 0; i < categoryCount_; ++i) {
+        size_t entry = layout.categories + i * kCategoryEntrySize;
+        if (load<uint32_t>(data_, entry + 4)) {
+            result.categoryTotals[std::string(string(load<uint32_t>(data_, entry)))] =
+                Money(load<int64_t>(data_, entry + 8), currency);
+        }
+    }
+
+    result.recurring.reserve(seriesCount_);
+    for (size_t i = 0; i < seriesCount_; ++i) {
+        size_t record = layout.series + i * kSeriesRecordSize;
+        auto text = [&](size_t field) { return std::string(string(load<uint32_t>(data_, record + field * 4))); };
+        RecurringSeries series;
+        series.merchant = text(0);
+        series.description = text(1);
+        series.cadence = text(2);
+        series.type = text(3);
+        series.firstDate = text(4);
+        series.lastDate = text(5);
+        series.nextDate = text(6);
+        series.occurrences = load<uint32_t>(data_, record + 28);
+        uint32_t begin = load<uint32_t>(data_, record + 32);
+        uint32_t length = load<uint32_t>(data_, record + 36);
+        series.active = load<uint32_t>(data_, record + 40) != 0;
+        CurrencyCode seriesCurrency = load<uint32_t>(data_, record + 44);
+        series.averageAmount = Money(load<int64_t>(data_, record + 48), seriesCurrency);
+        series.lastAmount = Money(load<int64_t>(data_, record + 56), seriesCurrency);
+        series.intervalDays = load<double>(data_, record + 64);
+        series.confidence = load<double>(data_, record + 72);
+        series.nextAmount = Money(load<int64_t>(data_, record + 80), seriesCurrency);
+        for (uint32_t j = 0; j < length; ++j) {
+            series.transactions.push_back(load<uint32_t>(data_, layout.seriesIndices + (begin + j) * 4));
+        }
+        result.recurring.push_back(std::move(series));
+    }
+
+    result.transfers.reserve(transferCount_);
+    for (size_t i = 0; i < transferCount_; ++i) {
+        size_t record = layout.transfers + i * kTransferRecordSize;
+        TransferPair pair;
+        pair.debit = load<uint32_t>(data_, record);
+        pair.credit = load<uint32_t>(data_, record + 4);
+        pair.amount = Money(load<int64_t>(data_, record + 16), load<uint32_t>(data_, record + 8));
+        pair.dayGap = load<int64_t>(data_, record + 24);
+        result.transfers.push_back(pair);
+    }
+    return result;
+}
+
+} // namespace BankAnalyzer
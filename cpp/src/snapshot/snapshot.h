@@ -0,0 +1,122 @@
+#pragma once
+#include "../extractor/transaction_extractor.h"
+#include "../analyzer/analyzer.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace BankAnalyzer {
+
+/**
+ * Snapshot format version. Bump it whenever the layout below changes or the
+ * extractor starts producing different transactions for the same text, so
+ * cached snapshots from older builds are ignored instead of reused.
+ */
+constexpr uint16_t kSnapshotVersion = 4;
+
+/**
+ * Cache key for a statement: 64-bit hash of its text (not cryptographic;
+ * identical text always gives the same key)
+ */
+uint64_t hashStatementText(std::string_view text);
+
+/**
+ * The key as 16 lower-case hex digits (file names, IndexedDB keys)
+ */
+std::string formatSnapshotKey(uint64_t hash);
+
+/**
+ * Serialize one statement's transactions and their analysis.
+ *
+ * Layout (little-endian, every section 8-byte aligned, sizes follow from the
+ * header counts):
+ *   header        magic "TLSN", version, source hash, counts
+ *   columns       amount i64, balance i64 (minor units), currency u32,
+ *                 date/description/account string id u32,
+ *                 category/merchant table index u32, flags u8
+ *                 (credit, hasBalance, balanceMismatch)
+ *   tables        categories (name, category total), merchants (name, from
+ *                 normalizeMerchant)
+ *   aggregates    income, expenses, net change and their currency (also
+ *                 the category totals'), recurring series and their
+ *                 transaction indices, transfer pairs (debit and
+ *                 credit row, amount, day gap)
+ *   string pool   offsets u32, then the bytes; each distinct string once
+ *
+ * The result can be written to a file and mmap'd, or stored as an
+ * ArrayBuffer in IndexedDB, and read back with SnapshotView.
+ * @param sourceHash hashStatementText() of the text the transactions came from
+ */
+std::string buildSnapshot(const std::vector<Transaction>& transactions, const AnalysisResult& analysis,
+                          uint64_t sourceHash);
+
+/**
+ * Read-only view over a snapshot. Nothing is copied: columns and strings are
+ * read in place, so the bytes (mapped file, WASM heap copy) must outlive the
+ * view.
+ */
+class SnapshotView {
+public:
+    /**
+     * Byte offset of each section (see buildSnapshot())
+     */
+    struct Sections {
+        size_t amount = 0, balance = 0, currency = 0, date = 0, description = 0, account = 0, category = 0, merchant = 0;
+        size_t flags = 0;
+        size_t categories = 0, merchants = 0, aggregates = 0, series = 0, seriesIndices = 0, transfers = 0;
+        size_t stringOffsets = 0, stringBytes = 0, end = 0;
+    };
+
+    /**
+     * Check and attach to a snapshot
+     * @param bytes Snapshot produced by buildSnapshot()
+     * @param error Receives a description of the failure, if any
+     * @return false for a truncated, corrupt or other-version snapshot
+     */
+    bool open(std::string_view bytes, std::string& error);
+
+    uint64_t sourceHash() const { return sourceHash_; }
+    size_t size() const { return count_; }
+
+    std::string_view date(size_t row) const;
+    std::string_view description(size_t row) const;
+    std::string_view account(size_t row) const;
+    std::string_view category(size_t row) const;
+    std::string_view merchant(size_t row) const;
+    Money amount(size_t row) const;
+    Money balance(size_t row) const;
+    bool isCredit(size_t row) const;
+
+    size_t categoryCount() const { return categoryCount_; }
+    std::string_view categoryName(size_t index) const;
+    size_t merchantCount() const { return merchantCount_; }
+    std::string_view merchantName(size_t index) const;
+
+    /**
+     * Column indices into the category/merchant tables, for callers that
+     * group rows without comparing strings
+     */
+    uint32_t categoryIndex(size_t row) const;
+    uint32_t merchantIndex(size_t row) const;
+
+    Transaction transaction(size_t row) const;
+    std::vector<Transaction> transactions() const;
+    AnalysisResult analysis() const;
+
+private:
+    std::string_view string(uint32_t id) const;
+    uint8_t flags(size_t row) const;
+
+    const char* data_ = nullptr;
+    Sections sections_;
+    uint64_t sourceHash_ = 0;
+    size_t count_ = 0;
+    size_t categoryCount_ = 0;
+    size_t merchantCount_ = 0;
+    size_t seriesCount_ = 0;
+    size_t transferCount_ = 0;
+};
+
+} // namespace BankAnalyzer
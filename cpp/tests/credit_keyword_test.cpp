@@ -0,0 +1,54 @@
+// Rows whose direction only the description can tell: no direction column
+// and no balance column. The money-in keywords are a DescriptionPool bit, so
+// extract() and ExtractionJob must both still apply them.
+
+#include "test_support.h"
+#include "extractor/description_pool.h"
+#include "extractor/extraction_job.h"
+#include "extractor/transaction_extractor.h"
+#include <string>
+#include <vector>
+
+using namespace BankAnalyzer;
+
+namespace {
+
+const char* const kStatement =
+    "Jan 5 PAYROLL DEPOSIT ACME 2,500.00\n"
+    "Jan 6 COFFEE SHOP #12 4.50\n"
+    "Jan 7 Transfer from savings 300.00\n"
+    "Jan 8 INTERAC E-TRANSFER RECEIVED 45.00\n"
+    "Jan 9 GROCERY STORE 82.10\n";
+
+bool expectedTypes(const std::vector<Transaction>& rows) {
+    const char* const types[] = {"credit", "debit", "credit", "credit", "debit"};
+    if (rows.size() != 5) {
+        return false;
+    }
+    for (size_t i = 0; i < rows.size(); ++i) {
+        if (rows[i].type != types[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    DescriptionPool pool;
+    TELLER_CHECK(pool.hasAny(pool.intern("Mobile autodeposit"), kKeywordCredit));
+    TELLER_CHECK(pool.hasAny(pool.intern("credit memo"), kKeywordCredit));
+    TELLER_CHECK(!pool.hasAny(pool.intern("SHELL OIL 5512"), kKeywordCredit));
+
+    TransactionExtractor extractor;
+    TELLER_CHECK(expectedTypes(extractor.extract(kStatement)));
+    TELLER_CHECK(extractor.stats().balance.keywordFallbacks == 5);
+
+    ExtractionJob job(extractor, kStatement);
+    while (!job.step(16).done) {
+    }
+    TELLER_CHECK(expectedTypes(job.takeTransactions()));
+
+    return Test::result();
+}
@@ -0,0 +1,53 @@
+// A date followed by hundreds of KB with no other date or line break. Record
+// windows once had no length limit, so this became one window, and the regex
+// patterns overflowed the stack searching it.
+
+#include "test_support.h"
+#include "extractor/pattern_pack.h"
+#include "extractor/transaction_extractor.h"
+#include <string>
+#include <vector>
+
+using namespace BankAnalyzer;
+
+namespace {
+
+std::string longRecord(size_t words) {
+    std::string text = "01/02/2024 ";
+    for (size_t i = 0; i < words; ++i) {
+        text += "a ";
+    }
+    return text + "12.34";
+}
+
+bool windowsCover(const std::string& text, const std::vector<RecordWindow>& records) {
+    size_t end = 0;
+    for (const RecordWindow& record : records) {
+        if (record.begin != end || record.end <= record.begin ||
+            record.end - record.begin > kMaxRecordBytes) {
+            return false;
+        }
+        end = record.end;
+    }
+    return end == text.size();
+}
+
+} // namespace
+
+int main() {
+    std::string text = longRecord(200000);
+    TELLER_CHECK(windowsCover(text, segmentRecords(text)));
+
+    TransactionExtractor extractor;
+    extractor.addPatternPack(extendedPatternPack());
+    extractor.extract(text);
+    TELLER_CHECK(!extractor.stats().anyAborted());
+
+    // The row at the end of an oversize window survives the cut
+    std::string padded = "01/02/2024 " + std::string(3000, 'x') + "\n01/03/2024 COFFEE SHOP -4.50 100.00\n";
+    TELLER_CHECK(windowsCover(padded, segmentRecords(padded)));
+    std::vector<Transaction> rows = extractor.extract(padded);
+    TELLER_CHECK(rows.size() == 1 && rows[0].description == "COFFEE SHOP");
+
+    return Test::result();
+}
@@ -0,0 +1,63 @@
+// The extended (std::regex) patterns on a 1 MB record. One search over it
+// recursed deep enough to overflow the stack before the step budget or the
+// deadline could stop it; such a record must now count as budget exhausted.
+
+#include "test_support.h"
+#include "extractor/pattern_pack.h"
+#include "extractor/transaction_extractor.h"
+#include <string>
+#include <vector>
+
+using namespace BankAnalyzer;
+
+namespace {
+
+// The extractor's handling of one pattern: stop on BudgetExceeded, mark the
+// pattern aborted and discard what it found
+std::vector<Transaction> runPattern(const PatternDefinition& pattern, const std::string& text,
+                                    const std::vector<RecordWindow>& records, PatternStats& stats) {
+    MatchBudget budget(UINT64_MAX, MatchBudget::Clock::time_point(), false);
+    std::string lastDate;
+    DescriptionPool descriptions;
+    PatternContext ctx{stats, budget, records, lastDate, descriptions};
+    try {
+        return pattern.run(text, ctx);
+    } catch (const BudgetExceeded&) {
+        stats.aborted = true;
+        return {};
+    }
+}
+
+} // namespace
+
+int main() {
+    std::string text = "01/02/2024 ";
+    while (text.size() < (1u << 20)) {
+        text += "a ";
+    }
+    text += "12.34";
+    const std::vector<RecordWindow> whole = {{0, text.size()}};
+
+    const PatternPack& pack = extendedPatternPack();
+    for (size_t i = 0; i < pack.count; ++i) {
+        PatternStats stats;
+        TELLER_CHECK(runPattern(pack.patterns[i], text, whole, stats).empty());
+        TELLER_CHECK(stats.aborted);
+    }
+
+    // A record at the ceiling is still searched
+    std::string row = "01/02/2024 ";
+    while (row.size() + 4 < kMaxRegexInput) {
+        row += row.size() + 12 < kMaxRegexInput ? "COFFEE " : "x";
+    }
+    row += "4.50";
+    TELLER_CHECK(row.size() == kMaxRegexInput);
+    const std::vector<RecordWindow> fits = {{0, row.size()}};
+    for (size_t i = 0; i < pack.count; ++i) {
+        PatternStats stats;
+        runPattern(pack.patterns[i], row, fits, stats);
+        TELLER_CHECK(!stats.aborted);
+    }
+
+    return Test::result();
+}
@@ -0,0 +1,86 @@
+// Arena memory freed on a thread other than the one that allocated it.
+// Deletes once only recognised the calling thread's arena and sent anything
+// else to free(), which aborted.
+
+#include "test_support.h"
+#include "extractor/scratch_arena.h"
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace BankAnalyzer;
+
+namespace {
+
+// Long enough to skip the small-string buffer and be a real allocation
+const std::string kText(200, 'x');
+
+bool inThisArena(const void* p) {
+    return ScratchArena::forThisThread().owns(p);
+}
+
+} // namespace
+
+int main() {
+    // A std::thread's state comes from the starting thread's arena and is
+    // freed by the new thread
+    {
+        ScratchScope scratch;
+        int ran = 0;
+        std::thread worker([&] { ran = 1; });
+        worker.join();
+        TELLER_CHECK(ran == 1);
+    }
+
+    // A block allocated here, deleted on another thread
+    {
+        ScratchScope scratch;
+        std::string* text = new std::string(kText);
+        TELLER_CHECK(!TELLER_SCRATCH_ARENA || inThisArena(text));
+        std::thread worker([text] { delete text; });
+        worker.join();
+    }
+
+    // A future's shared state, released by whichever side lets go last
+    {
+        ScratchScope scratch;
+        std::future<std::string> result = std::async(std::launch::async, [] { return kText; });
+        TELLER_CHECK(result.get() == kText);
+    }
+
+    // A block from a worker's arena, deleted here while the worker is alive
+    {
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::vector<int>* values = nullptr;
+        bool deleted = false;
+        std::thread worker([&] {
+            ScratchScope scratch;
+            std::vector<int>* made = new std::vector<int>(1000, 7);
+            std::unique_lock<std::mutex> lock(mutex);
+            values = made;
+            changed.notify_all();
+            changed.wait(lock, [&] { return deleted; });
+        });
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&] { return values != nullptr; });
+            TELLER_CHECK(values->size() == 1000 && (*values)[999] == 7);
+            TELLER_CHECK(!inThisArena(values));
+            delete values;
+            deleted = true;
+            changed.notify_all();
+        }
+        worker.join();
+    }
+
+    // Plain heap blocks still go back to the heap
+    std::string* heap = new std::string(kText);
+    TELLER_CHECK(!inThisArena(heap));
+    delete heap;
+
+    return Test::result();
+}
@@ -0,0 +1,126 @@
+// SnapshotView::open() on snapshots whose header counts don't fit the bytes.
+// The section layout was once summed in size_t, which on wasm32 could wrap
+// past the size check and let the validation loops read out of bounds.
+// Also round-trips a two-account ledger: the account column and the transfer
+// pairs were once left out, so a cached ledger lost its transfers.
+
+#include "test_support.h"
+#include "snapshot/snapshot.h"
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace BankAnalyzer;
+
+namespace {
+
+// Offsets of the header's u32 section counts (see buildSnapshot())
+const size_t kCountOffsets[] = {20, 24, 28, 32, 36, 40, 44, 48};
+
+std::vector<Transaction> sampleLedger() {
+    std::vector<Transaction> transactions;
+    for (int i = 0; i < 20; ++i) {
+        Transaction txn;
+        txn.date = "2024-01-" + std::to_string(10 + i);
+        txn.description = i % 2 ? "PAYROLL DEPOSIT" : "COFFEE SHOP #12";
+        txn.amount = Money(1000 + i);
+        txn.type = i % 2 ? "credit" : "debit";
+        txn.category = "uncategorized";
+        transactions.push_back(txn);
+    }
+    return transactions;
+}
+
+// Chequing pays the card and moves money to savings; both land on the other side
+std::vector<Transaction> twoAccountLedger() {
+    struct Row {
+        const char* account;
+        const char* date;
+        const char* description;
+        int64_t amount;
+        const char* type;
+    };
+    const Row rows[] = {
+        {"chequing.pdf", "2024-01-05", "PAYROLL DEPOSIT", 250000, "credit"},
+        {"chequing.pdf", "2024-01-10", "CARD PAYMENT", 45000, "debit"},
+        {"chequing.pdf", "2024-01-12", "TRANSFER TO SAVINGS", 100000, "debit"},
+        {"savings.pdf", "2024-01-13", "TRANSFER FROM CHEQUING", 100000, "credit"},
+        {"savings.pdf", "2024-01-20", "COFFEE SHOP #12", 575, "debit"},
+        {"savings.pdf", "2024-01-11", "PAYMENT RECEIVED", 45000, "credit"},
+    };
+    std::vector<Transaction> transactions;
+    for (const Row& row : rows) {
+        Transaction txn;
+        txn.account = row.account;
+        txn.date = row.date;
+        txn.description = row.description;
+        txn.amount = Money(row.amount);
+        txn.type = row.type;
+        txn.category = "uncategorized";
+        transactions.push_back(txn);
+    }
+    return transactions;
+}
+
+std::string withCount(std::string bytes, size_t offset, uint32_t value) {
+    std::memcpy(&bytes[offset], &value, sizeof(value));
+    return bytes;
+}
+
+bool opens(const std::string& bytes) {
+    SnapshotView view;
+    std::string error;
+    return view.open(bytes, error);
+}
+
+} // namespace
+
+int main() {
+    std::vector<Transaction> transactions = sampleLedger();
+    std::string bytes = buildSnapshot(transactions, AnalysisResult(), hashStatementText("sample"));
+
+    SnapshotView view;
+    std::string error;
+    TELLER_CHECK(view.open(bytes, error));
+    TELLER_CHECK(view.size() == transactions.size());
+    TELLER_CHECK(view.description(1) == "PAYROLL DEPOSIT");
+
+    TELLER_CHECK(!opens(bytes.substr(0, bytes.size() - 1)));
+
+    // Counts far past the bytes, including ones whose section sizes wrap in
+    // 32 bits (0x20000000 rows of 8 bytes) and the largest string count
+    for (size_t offset : kCountOffsets) {
+        for (uint32_t count : {0x20000000u, 0x40000000u, 0x80000000u, 0xFFFFFFFFu}) {
+            TELLER_CHECK(!opens(withCount(bytes, offset, count)));
+        }
+    }
+
+    // A consistent header (end matches the counts) that claims more than is there
+    std::string grown = withCount(bytes, 20, 0xFFFFFFFFu);
+    TELLER_CHECK(!opens(withCount(grown, 16, 0xFFFFFFF8u)));
+
+    // Accounts and transfer pairs survive the round trip
+    std::vector<Transaction> ledger = twoAccountLedger();
+    AnalysisResult analysis = Analyzer().analyze(ledger);
+    TELLER_CHECK(analysis.transfers.size() == 2);
+    SnapshotView ledgerView;
+    TELLER_CHECK(ledgerView.open(buildSnapshot(ledger, analysis, hashStatementText("ledger")), error));
+    TELLER_CHECK(ledgerView.size() == ledger.size());
+    for (size_t row = 0; row < ledger.size(); ++row) {
+        TELLER_CHECK(ledgerView.account(row) == ledger[row].account);
+        TELLER_CHECK(ledgerView.transaction(row).account == ledger[row].account);
+    }
+    AnalysisResult restored = ledgerView.analysis();
+    TELLER_CHECK(restored.transfers.size() == analysis.transfers.size());
+    for (size_t i = 0; i < restored.transfers.size() && i < analysis.transfers.size(); ++i) {
+        TELLER_CHECK(restored.transfers[i].debit == analysis.transfers[i].debit);
+        TELLER_CHECK(restored.transfers[i].credit == analysis.transfers[i].credit);
+        TELLER_CHECK(restored.transfers[i].amount == analysis.transfers[i].amount);
+        TELLER_CHECK(restored.transfers[i].dayGap == analysis.transfers[i].dayGap);
+    }
+    TELLER_CHECK(restored.totalIncome == analysis.totalIncome);
+    TELLER_CHECK(restored.totalExpenses == analysis.totalExpenses);
+
+    return Test::result();
+}
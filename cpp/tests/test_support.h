@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdio>
+
+// Minimal checks for the regression tests: report and count failures, keep going
+namespace BankAnalyzer {
+namespace Test {
+
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+inline void check(bool ok, const char* what, const char* file, int line) {
+    if (!ok) {
+        std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, what);
+        ++failures();
+    }
+}
+
+inline int result() {
+    if (failures() == 0) {
+        std::printf("ok\n");
+        return 0;
+    }
+    std::fprintf(stderr, "%d check(s) failed\n", failures());
+    return 1;
+}
+
+} // namespace Test
+} // namespace BankAnalyzer
+
+#define TELLER_CHECK(condition) ::BankAnalyzer::Test::check((condition), #condition, __FILE__, __LINE__)
@@ -0,0 +1,27 @@
+// Tasks that submit more tasks from inside the pool. The nested task was once
+// queued before it was counted, so a thief could finish it first and wait()
+// returned while the task that submitted it was still running.
+
+#include "test_support.h"
+#include "thread_pool.h"
+#include <atomic>
+
+using namespace BankAnalyzer;
+
+int main() {
+    ThreadPool pool(4);
+    for (int round = 0; round < 200; ++round) {
+        std::atomic<int> finished{0};
+        for (int i = 0; i < 8; ++i) {
+            pool.submit([&](size_t) {
+                for (int j = 0; j < 4; ++j) {
+                    pool.submit([&](size_t) { finished.fetch_add(1); });
+                }
+                finished.fetch_add(1);
+            });
+        }
+        pool.wait();
+        TELLER_CHECK(finished.load() == 8 * 5);
+    }
+    return Test::result();
+}
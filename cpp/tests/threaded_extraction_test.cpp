@@ -0,0 +1,71 @@
+// Extraction of a statement large enough that segmentRecords() splits it
+// across kernel worker threads. The workers' std::thread state once came
+// from the caller's scratch arena and was freed by the worker itself, which
+// aborted in free(); the result must also match a single-threaded run.
+
+#include "test_support.h"
+#include "extractor/transaction_extractor.h"
+#include "kernels.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace BankAnalyzer;
+
+namespace {
+
+// About 2.4 MB of "Jan 5 DESCRIPTION   12.34   9,876.54" rows
+std::string largeStatement() {
+    const char* const descriptions[] = {
+        "STARBUCKS COFFEE #1234", "E-TRANSFER SENT JOHN", "PAYROLL DEPOSIT ACME CORP",
+        "LOBLAWS #552", "SHELL OIL 5512",
+    };
+    std::string text;
+    long long balance = 100000000;
+    char line[128];
+    for (int i = 0; text.size() < (2400u << 10); ++i) {
+        long long cents = 100 + (i * 7919) % 19900;
+        balance -= cents;
+        std::snprintf(line, sizeof(line), "Jan %d %s   %lld.%02lld   %lld.%02lld\n",
+                      1 + i % 28, descriptions[i % 5], cents / 100, cents % 100,
+                      balance / 100, balance % 100);
+        text += line;
+    }
+    return text;
+}
+
+bool sameRows(const std::vector<Transaction>& a, const std::vector<Transaction>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].date != b[i].date || a[i].description != b[i].description ||
+            a[i].amount != b[i].amount || a[i].type != b[i].type) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    std::string text = largeStatement();
+    TransactionExtractor extractor;
+
+    setKernelThreads(1);
+    std::vector<Transaction> single = extractor.extract(text);
+    TELLER_CHECK(single.size() > 40000);
+
+    setKernelThreads(4);
+    std::vector<Transaction> threaded = extractor.extract(text);
+    TELLER_CHECK(sameRows(single, threaded));
+
+    std::vector<Transaction> pinned = extractor.extractWithPattern(extractor.stats().matchedPattern, text);
+    TELLER_CHECK(sameRows(single, pinned));
+
+    // Again, now that the arena has been rewound and reused
+    TELLER_CHECK(sameRows(single, extractor.extract(text)));
+
+    return Test::result();
+}
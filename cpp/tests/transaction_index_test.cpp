@@ -0,0 +1,68 @@
+// Sorted queries over rows with equal keys. A descending query once walked
+// the ascending order backwards, which also reversed rows with the same key;
+// ties must stay in ledger order in both directions.
+
+#include "test_support.h"
+#include "query/transaction_index.h"
+#include <string>
+#include <vector>
+
+using namespace BankAnalyzer;
+
+namespace {
+
+Transaction row(const std::string& date, const std::string& description, int64_t cents,
+                const std::string& type, const std::string& category) {
+    Transaction txn;
+    txn.date = date;
+    txn.description = description;
+    txn.amount = Money(cents);
+    txn.type = type;
+    txn.category = category;
+    return txn;
+}
+
+std::vector<uint32_t> sorted(TransactionIndex& index, SortKey key, bool descending) {
+    TransactionQuery request;
+    request.sort = key;
+    request.descending = descending;
+    request.limit = 0;
+    return index.query(request).rows;
+}
+
+} // namespace
+
+int main() {
+    std::vector<Transaction> ledger = {
+        row("2024-01-02", "COFFEE", 500, "debit", "dining"),     // 0
+        row("2024-01-01", "RENT", 150000, "debit", "housing"),   // 1
+        row("2024-01-02", "PAYROLL", 300000, "credit", "income"), // 2
+        row("2024-01-01", "COFFEE", 500, "debit", "dining"),     // 3
+        row("2024-01-02", "GROCER", 8000, "debit", "groceries"), // 4
+    };
+    TransactionIndex index;
+    index.build(ledger);
+
+    TELLER_CHECK((sorted(index, SortKey::Date, false) == std::vector<uint32_t>{1, 3, 0, 2, 4}));
+    TELLER_CHECK((sorted(index, SortKey::Date, true) == std::vector<uint32_t>{0, 2, 4, 1, 3}));
+
+    TELLER_CHECK((sorted(index, SortKey::Amount, false) == std::vector<uint32_t>{0, 3, 4, 1, 2}));
+    TELLER_CHECK((sorted(index, SortKey::Amount, true) == std::vector<uint32_t>{2, 1, 4, 0, 3}));
+
+    TELLER_CHECK((sorted(index, SortKey::Type, true) == std::vector<uint32_t>{0, 1, 3, 4, 2}));
+
+    // Pages of a descending query line up with the whole order
+    TransactionQuery page;
+    page.sort = SortKey::Date;
+    page.descending = true;
+    page.offset = 1;
+    page.limit = 2;
+    TELLER_CHECK((index.query(page).rows == std::vector<uint32_t>{2, 4}));
+
+    // A category edit rebuilds both directions
+    index.setCategory(4, "dining");
+    TELLER_CHECK((sorted(index, SortKey::Category, false) == std::vector<uint32_t>{0, 3, 4, 1, 2}));
+    TELLER_CHECK((sorted(index, SortKey::Category, true) == std::vector<uint32_t>{2, 1, 0, 3, 4}));
+
+    return Test::result();
+}
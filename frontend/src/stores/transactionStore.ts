@@ -9,13 +9,35 @@ export interface Transaction {
   balance: number;
   type: 'debit' | 'credit';
   category: string;
+  balanceMismatch?: boolean; // Balance doesn't follow from the previous row's
+  currency?: string; // ISO code when the statement names one ("EUR"), else ""
+}
+
+export interface RecurringSeries {
+  merchant: string;
+  description: string;
+  cadence: 'weekly' | 'biweekly' | 'monthly' | 'annual';
+  type: 'debit' | 'credit';
+  occurrences: number;
+  averageAmount: number;
+  lastAmount: number;
+  intervalDays: number;
+  confidence: number;
+  active: boolean;
+  firstDate: string;
+  lastDate: string;
+  nextDate: string;
+  nextAmount: number;
+  transactions: number[]; // Indices into the analyzed transactions
 }
 
 export interface AnalysisResult {
   totalIncome: number;
   totalExpenses: number;
   netChange: number;
+  currency?: string; // Shared by every transaction, else ""
   categoryTotals: Record<string, number>;
+  recurring: RecurringSeries[];
 }
 
 // Store for all transactions
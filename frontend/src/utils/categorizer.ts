@@ -1,6 +1,8 @@
 // Transaction categorization using rule-based matching
 // Can be enhanced with ML in the future
 
+import { memoizeByDescription } from './descriptionCache';
+
 export interface CategoryRule {
   category: string;
   keywords: string[];
@@ -202,11 +204,19 @@ const CATEGORY_RULES: CategoryRule[] = [
   }
 ];
 
+// Rule matches per distinct description; credits also check the income rules
+const creditCategories = memoizeByDescription(description => matchCategoryRules(description, 'credit'));
+const debitCategories = memoizeByDescription(description => matchCategoryRules(description, 'debit'));
+
 /**
  * Categorize a transaction based on its description
- * Uses rule-based keyword matching
+ * Uses rule-based keyword matching, once per distinct description
  */
 export function categorizeTransaction(description: string, type: string): string {
+  return type === 'credit' ? creditCategories(description) : debitCategories(description);
+}
+
+function matchCategoryRules(description: string, type: string): string {
   const lowerDesc = description.toLowerCase();
 
   // Check for income-related keywords first (for credit transactions)
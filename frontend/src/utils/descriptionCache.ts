@@ -0,0 +1,27 @@
+// Per-description memo for work that depends only on a transaction's
+// description (categorizing, merchant extraction, tokenizing). Statements
+// repeat the same few descriptions row after row, so each distinct one is
+// processed once. The same idea as DescriptionPool in the extractor.
+
+const DEFAULT_LIMIT = 10000;
+
+/**
+ * Wrap fn so each distinct description is computed once.
+ * Callers share the cached value, so it must not be mutated. A cache that
+ * reaches `limit` entries starts over rather than growing without bound.
+ */
+export function memoizeByDescription<T>(
+  fn: (description: string) => T,
+  limit: number = DEFAULT_LIMIT
+): (description: string) => T {
+  const cache = new Map<string, T>();
+  return (description: string): T => {
+    const cached = cache.get(description);
+    if (cached !== undefined) return cached;
+
+    const value = fn(description);
+    if (cache.size >= limit) cache.clear();
+    cache.set(description, value);
+    return value;
+  };
+}
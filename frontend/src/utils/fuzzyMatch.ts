@@ -1,5 +1,7 @@
 // Fuzzy string matching utilities for merchant name recognition
 
+import { memoizeByDescription } from './descriptionCache';
+
 /**
  * Calculate Levenshtein distance between two strings
  * Lower distance = more similar strings
@@ -116,8 +118,11 @@ export function cleanMerchantName(name: string): string {
 /**
  * Extract merchant name from transaction description
  * Handles common formats like "PURCHASE AT MERCHANT NAME" or "DEBIT CARD MERCHANT"
+ * (computed once per distinct description)
  */
-export function extractMerchantName(description: string): string {
+export const extractMerchantName = memoizeByDescription(extractMerchantNameUncached);
+
+function extractMerchantNameUncached(description: string): string {
   let merchant = description.trim();
 
   // Remove common prefixes
@@ -12,6 +12,7 @@ export interface AnalysisLogEntry {
   categories: string[];
   dateRange: { start: string; end: string } | null;
   processingTime: number;
+  extractorStats?: any; // getExtractorStats() output: which pattern matched and where time went
   success: boolean;
   error?: string;
   extractedText?: string; // Sample for JSON log
@@ -0,0 +1,88 @@
+/**
+ * Statement snapshot cache (IndexedDB)
+ * Opt-in: when enabled, each processed statement is stored as a binary snapshot keyed by a
+ * hash of its text, so uploading the same statement again is a lookup and previously
+ * processed statements can be reopened after a reload without re-parsing the PDFs.
+ * Nothing leaves the device; clearSnapshotCache() deletes everything.
+ */
+
+const DB_NAME = 'teller';
+const DB_VERSION = 1;
+const STORE_NAME = 'snapshots';
+const ENABLED_KEY = 'teller-snapshot-cache';
+
+export interface CachedSnapshot {
+  key: string;          // hashStatement() of the statement text
+  fileName: string;
+  savedAt: string;      // ISO timestamp
+  bytes: Uint8Array;    // encodeSnapshot() output
+}
+
+let dbPromise: Promise<IDBDatabase> | null = null;
+
+export function isSnapshotCacheEnabled(): boolean {
+  return localStorage.getItem(ENABLED_KEY) === 'on';
+}
+
+/**
+ * Turn the cache on or off; turning it off deletes the stored snapshots
+ */
+export async function setSnapshotCacheEnabled(enabled: boolean): Promise<void> {
+  if (enabled) {
+    localStorage.setItem(ENABLED_KEY, 'on');
+  } else {
+    localStorage.removeItem(ENABLED_KEY);
+    await clearSnapshotCache();
+  }
+}
+
+function openDatabase(): Promise<IDBDatabase> {
+  if (dbPromise) return dbPromise;
+
+  dbPromise = new Promise((resolve, reject) => {
+    const request = indexedDB.open(DB_NAME, DB_VERSION);
+    request.onupgradeneeded = () => {
+      request.result.createObjectStore(STORE_NAME, { keyPath: 'key' });
+    };
+    request.onsuccess = () => resolve(request.result);
+    request.onerror = () => {
+      dbPromise = null;
+      reject(request.error);
+    };
+  });
+  return dbPromise;
+}
+
+async function runRequest<T>(mode: IDBTransactionMode, makeRequest: (store: IDBObjectStore) => IDBRequest<T>): Promise<T> {
+  const db = await openDatabase();
+  return new Promise((resolve, reject) => {
+    const request = makeRequest(db.transaction(STORE_NAME, mode).objectStore(STORE_NAME));
+    request.onsuccess = () => resolve(request.result);
+    request.onerror = () => reject(request.error);
+  });
+}
+
+export async function getCachedSnapshot(key: string): Promise<CachedSnapshot | null> {
+  const entry = await runRequest('readonly', (store) => store.get(key));
+  return entry ?? null;
+}
+
+export async function putCachedSnapshot(snapshot: CachedSnapshot): Promise<void> {
+  await runRequest('readwrite', (store) => store.put(snapshot));
+}
+
+/**
+ * Every stored snapshot, oldest first
+ */
+export async function listCachedSnapshots(): Promise<CachedSnapshot[]> {
+  const entries: CachedSnapshot[] = await runRequest('readonly', (store) => store.getAll());
+  return entries.sort((a, b) => a.savedAt.localeCompare(b.savedAt));
+}
+
+export async function deleteCachedSnapshot(key: string): Promise<void> {
+  await runRequest('readwrite', (store) => store.delete(key));
+}
+
+export async function clearSnapshotCache(): Promise<void> {
+  await runRequest('readwrite', (store) => store.clear());
+}
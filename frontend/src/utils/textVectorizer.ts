@@ -2,6 +2,14 @@
 // Converts transaction descriptions into numerical features
 
 import { normalizeMerchantName } from './fuzzyMatch';
+import { memoizeByDescription } from './descriptionCache';
+
+// Words of a description, split once per distinct description (shared: don't mutate)
+const tokenizeDescription = memoizeByDescription(text =>
+  normalizeMerchantName(text)
+    .split(/\s+/)
+    .filter(word => word.length > 0)
+);
 
 export interface VocabularyItem {
   word: string;
@@ -50,13 +58,7 @@ export class TextVectorizer {
    * Tokenize text into words
    */
   private tokenize(text: string): string[] {
-    // Normalize the text
-    const normalized = normalizeMerchantName(text);
-
-    // Split into words and filter out empty strings
-    return normalized
-      .split(/\s+/)
-      .filter(word => word.length > 0);
+    return tokenizeDescription(text);
   }
 
   /**
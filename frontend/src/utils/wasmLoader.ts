@@ -1,6 +1,10 @@
 /**
  * WASM Module Loader
- * Loads PDF.js (for PDF parsing) and our custom Bank Analyzer module (for transaction extraction/analysis)
+ * Loads PDF.js (for PDF parsing) and our custom Bank Analyzer module (for transaction extraction/analysis).
+ * The Bank Analyzer base module only knows the common layouts (Patterns 2, 1, 3); the extended
+ * pattern pack (Patterns 10, 4-9) is a separate module fetched the first time the base finds nothing.
+ * Each module comes in three builds (baseline, simd, simd-threads); the loader picks the fastest one
+ * the browser runs and falls back to baseline if that build can't be loaded.
  */
 import * as pdfjsLib from 'pdfjs-dist';
 
@@ -9,6 +13,19 @@ let analyzerModule: any = null;
 let analyzerLoading = false;
 let analyzerPromise: Promise<any> | null = null;
 
+// Extended pattern pack module, loaded on demand
+let patternPackModule: any = null;
+let patternPackPromise: Promise<any> | null = null;
+
+// Extraction limits to apply to the pattern pack when it loads
+let extractionLimits: { stepsPerByte: number; deadlineMs: number } | null = null;
+
+// Scratch arena cap (MB) to apply to the pattern pack when it loads
+let scratchCapacityMb: number | null = null;
+
+// Modules that took part in the last extractTransactions()/extractTransactionsSliced() call
+let lastExtractionModules: any[] = [];
+
 // PDF.js initialization
 let pdfjsInitialized = false;
 
@@ -46,6 +63,70 @@ function loadScript(src: string, globalName: string): Promise<any> {
   });
 }
 
+/**
+ * Module builds, fastest last (see TELLER_WASM_VARIANT in cpp/CMakeLists.txt)
+ */
+export type WasmVariant = 'baseline' | 'simd' | 'simd-threads';
+
+// Smallest module using a simd128 instruction; only validates where simd128 is supported
+const SIMD_PROBE = new Uint8Array([
+  0, 97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3, 2, 1, 0, 10, 10, 1, 8, 0, 65, 0, 253, 15, 253, 98, 11
+]);
+
+/**
+ * The fastest build this browser runs: simd128 if WebAssembly validates a SIMD
+ * instruction, with threads if the page is also cross-origin isolated
+ * (SharedArrayBuffer needs the COOP/COEP headers)
+ */
+export function detectWasmVariant(): WasmVariant {
+  let simd = false;
+  try {
+    simd = typeof WebAssembly === 'object' && WebAssembly.validate(SIMD_PROBE);
+  } catch {
+    simd = false;
+  }
+  if (!simd) return 'baseline';
+
+  const isolated = typeof SharedArrayBuffer !== 'undefined' && (globalThis as any).crossOriginIsolated === true;
+  return isolated ? 'simd-threads' : 'simd';
+}
+
+/**
+ * Load and initialize one of our modules in the given build
+ */
+async function instantiateVariant(name: string, globalName: string, variant: WasmVariant): Promise<any> {
+  const script = variant === 'baseline' ? `/wasm/${name}.js` : `/wasm/${name}.${variant}.js`;
+  const ModuleFactory = await loadScript(script, globalName);
+  const module = await ModuleFactory({
+    locateFile: (file: string) => `/wasm/${file}`,
+    // Worker threads load the same script
+    mainScriptUrlOrBlob: script
+  });
+
+  if (variant === 'simd-threads') {
+    module.setThreadCount(navigator.hardwareConcurrency || 1);
+  }
+  return module;
+}
+
+/**
+ * Load a module in the fastest build the browser supports, falling back to baseline
+ * (e.g. when only the baseline build is deployed)
+ */
+async function instantiateModule(name: string, globalName: string): Promise<any> {
+  const variant = detectWasmVariant();
+  if (variant !== 'baseline') {
+    try {
+      return await instantiateVariant(name, globalName, variant);
+    } catch (error) {
+      console.warn(`${name} (${variant}) unavailable, using the baseline build:`, error);
+      // Drop the variant's factory so loadScript() fetches the baseline one
+      delete (window as any)[globalName];
+    }
+  }
+  return instantiateVariant(name, globalName, 'baseline');
+}
+
 /**
  * Load the Bank Analyzer WASM module (C++ transaction extraction/analysis)
  */
@@ -56,16 +137,14 @@ export async function loadAnalyzerModule(): Promise<any> {
   analyzerLoading = true;
   analyzerPromise = new Promise(async (resolve, reject) => {
     try {
-      // Load the Emscripten-generated JS file
+      // Load and initialize the Emscripten-generated module
       // The global name is BankAnalyzerModule, not Module
-      const ModuleFactory = await loadScript('/wasm/bank_analyzer.js', 'BankAnalyzerModule');
+      analyzerModule = await instantiateModule('bank_analyzer', 'BankAnalyzerModule');
 
-      // Initialize the WASM module
-      analyzerModule = await ModuleFactory({
-        locateFile: (file: string) => `/wasm/${file}`
-      });
-
-      console.log('Bank Analyzer WASM module loaded');
+      const info = typeof analyzerModule.getKernelInfo === 'function' ? analyzerModule.getKernelInfo() : null;
+      console.log(info
+        ? `Bank Analyzer WASM module loaded (${info.kernels} kernels, ${info.threads} thread(s))`
+        : 'Bank Analyzer WASM module loaded');
       analyzerLoading = false;
       resolve(analyzerModule);
     } catch (error) {
@@ -78,6 +157,37 @@ export async function loadAnalyzerModule(): Promise<any> {
   return analyzerPromise;
 }
 
+/**
+ * Load the extended pattern pack (rarer statement layouts, std::regex based)
+ */
+export async function loadPatternPackModule(): Promise<any> {
+  if (patternPackModule) return patternPackModule;
+  if (patternPackPromise) return patternPackPromise;
+
+  patternPackPromise = (async () => {
+    const module = await instantiateModule('bank_analyzer_patterns', 'BankAnalyzerPatternsModule');
+
+    if (extractionLimits) {
+      module.setExtractionLimits(extractionLimits.stepsPerByte, extractionLimits.deadlineMs);
+    }
+    if (scratchCapacityMb !== null) {
+      module.setScratchCapacity(scratchCapacityMb);
+    }
+
+    console.log('Extended pattern pack loaded');
+    patternPackModule = module;
+    return module;
+  })();
+
+  try {
+    return await patternPackPromise;
+  } catch (error) {
+    // Allow a retry on the next statement
+    patternPackPromise = null;
+    throw error;
+  }
+}
+
 /**
  * Initialize PDF.js worker
  */
@@ -131,7 +241,140 @@ export async function parsePDF(pdfData: Uint8Array): Promise<string> {
  */
 export async function extractTransactions(text: string): Promise<any[]> {
   const module = await loadAnalyzerModule();
-  return module.extractTransactions(text);
+  const transactions = module.extractTransactions(text);
+  lastExtractionModules = [module];
+  if (transactions.length > 0) {
+    return transactions;
+  }
+
+  // None of the common layouts matched; try the rarer ones
+  try {
+    const patternPack = await loadPatternPackModule();
+    lastExtractionModules.push(patternPack);
+    return patternPack.extractTransactions(text);
+  } catch (error) {
+    console.error('Failed to load extended pattern pack:', error);
+    return transactions;
+  }
+}
+
+export interface ExtractionProgress {
+  bytesProcessed: number;   // Of the current pattern's pass over the text
+  totalBytes: number;
+  found: number;            // Rows the current pattern has found so far
+  pattern: number;          // Pattern running (once done, the one that matched or 0)
+  patternName: string;
+  patternsTried: number;
+  patternCount: number;
+  done: boolean;
+  cancelled: boolean;
+  fraction: number;         // Share of the module's cascade worked through, 0-1
+}
+
+export interface SlicedExtractionOptions {
+  sliceMs?: number;         // Work per slice before yielding to the browser (default 8)
+  signal?: AbortSignal;     // Abort to drop the statement; the promise rejects with an AbortError
+  onProgress?: (progress: ExtractionProgress) => void;
+}
+
+function abortError(): Error {
+  return new DOMException('Extraction cancelled', 'AbortError');
+}
+
+// Run one module's cascade a slice at a time, yielding to the event loop between slices
+async function extractSliced(module: any, text: string, options: SlicedExtractionOptions): Promise<any[]> {
+  const { sliceMs = 8, signal, onProgress } = options;
+  module.startExtraction(text);
+  for (;;) {
+    if (signal?.aborted) {
+      module.cancelExtraction();
+      throw abortError();
+    }
+    const progress = module.continueExtraction(0, sliceMs);
+    const passes = progress.patternsTried + (progress.totalBytes > 0 ? progress.bytesProcessed / progress.totalBytes : 0);
+    progress.fraction = progress.done ? 1 : passes / Math.max(progress.patternCount, 1);
+    onProgress?.(progress);
+    if (progress.done) {
+      if (progress.cancelled) throw abortError();
+      return progress.transactions;
+    }
+    await new Promise((resolve) => setTimeout(resolve, 0));
+  }
+}
+
+/**
+ * extractTransactions() without blocking the main thread: the C++ extractor runs in
+ * slices of about sliceMs, reporting progress after each and stopping as soon as the
+ * signal aborts. Same result as extractTransactions(), including the pattern pack fallback.
+ */
+export async function extractTransactionsSliced(
+  text: string,
+  options: SlicedExtractionOptions = {}
+): Promise<any[]> {
+  const module = await loadAnalyzerModule();
+  lastExtractionModules = [module];
+  const transactions = await extractSliced(module, text, options);
+  if (transactions.length > 0) {
+    return transactions;
+  }
+
+  // None of the common layouts matched; try the rarer ones
+  let patternPack: any;
+  try {
+    patternPack = await loadPatternPackModule();
+  } catch (error) {
+    console.error('Failed to load extended pattern pack:', error);
+    return transactions;
+  }
+  lastExtractionModules.push(patternPack);
+  return extractSliced(patternPack, text, options);
+}
+
+/**
+ * Per-pattern timings and match/reject counts for the last extractTransactions() call
+ * (merged across the base module and the pattern pack when both ran)
+ */
+export async function getExtractorStats(): Promise<any> {
+  const modules = lastExtractionModules.length > 0 ? lastExtractionModules : [await loadAnalyzerModule()];
+  return modules
+    .map((module) => module.getExtractorStats())
+    .reduce((merged, next) => ({
+      ...next,
+      deadlineExceeded: merged.deadlineExceeded || next.deadlineExceeded,
+      milliseconds: merged.milliseconds + next.milliseconds,
+      bytesScanned: merged.bytesScanned + next.bytesScanned,
+      allocations: merged.allocations + next.allocations,
+      scratchBytes: Math.max(merged.scratchBytes, next.scratchBytes),
+      scratchOverflows: merged.scratchOverflows + next.scratchOverflows,
+      patterns: [...merged.patterns, ...next.patterns],
+      aborted: [...merged.aborted, ...next.aborted]
+    }));
+}
+
+/**
+ * Bound extraction latency: per-pattern work budget (characters read per input
+ * byte) and a whole-document deadline in milliseconds (0 = none)
+ */
+export async function setExtractionLimits(stepsPerByte: number, deadlineMs: number): Promise<void> {
+  extractionLimits = { stepsPerByte, deadlineMs };
+  const module = await loadAnalyzerModule();
+  module.setExtractionLimits(stepsPerByte, deadlineMs);
+  if (patternPackModule) {
+    patternPackModule.setExtractionLimits(stepsPerByte, deadlineMs);
+  }
+}
+
+/**
+ * Cap the scratch memory each WASM module keeps for extraction/analysis
+ * (default 64 MB); larger statements spill to the regular heap
+ */
+export async function setScratchCapacity(megabytes: number): Promise<void> {
+  scratchCapacityMb = megabytes;
+  const module = await loadAnalyzerModule();
+  module.setScratchCapacity(megabytes);
+  if (patternPackModule) {
+    patternPackModule.setScratchCapacity(megabytes);
+  }
 }
 
 /**
@@ -142,6 +385,67 @@ export async function analyzeTransactions(transactions: any[]): Promise<any> {
   return module.analyzeTransactions(transactions);
 }
 
+/**
+ * Cache key for a statement's text (16 hex digits); identical text gives the same key
+ */
+export async function hashStatement(text: string): Promise<string> {
+  const module = await loadAnalyzerModule();
+  return module.hashStatement(text);
+}
+
+/**
+ * Compact binary snapshot of categorized transactions and their analysis (for IndexedDB)
+ */
+export async function encodeSnapshot(transactions: any[], key: string): Promise<Uint8Array> {
+  const module = await loadAnalyzerModule();
+  return module.encodeSnapshot(transactions, key);
+}
+
+/**
+ * Read a snapshot back: { key, transactions, analysis }, or null if it is corrupt or
+ * was written by a build with a different snapshot version
+ */
+export async function decodeSnapshot(bytes: Uint8Array): Promise<any | null> {
+  const module = await loadAnalyzerModule();
+  return module.decodeSnapshot(bytes);
+}
+
+export interface TransactionQuery {
+  text?: string;                 // Description substring, any case
+  type?: 'debit' | 'credit';
+  categories?: string[];         // Any of these
+  sort?: 'date' | 'description' | 'category' | 'merchant' | 'type' | 'amount' | 'balance';
+  descending?: boolean;
+  offset?: number;
+  limit?: number;                // Default 100, 0 = all
+}
+
+/**
+ * Load the transactions the table queries run against (builds the C++ query index).
+ * Call again whenever the list is replaced.
+ */
+export async function loadQueryLedger(transactions: any[]): Promise<void> {
+  const module = await loadAnalyzerModule();
+  module.loadQueryLedger(transactions);
+}
+
+/**
+ * Search, filter, sort and page the loaded ledger; rows are indices into the array
+ * passed to loadQueryLedger()
+ */
+export async function queryTransactions(query: TransactionQuery): Promise<{ total: number; rows: Uint32Array }> {
+  const module = await loadAnalyzerModule();
+  return module.queryTransactions(query);
+}
+
+/**
+ * Tell the query index about a category correction
+ */
+export async function setQueryCategory(row: number, category: string): Promise<void> {
+  const module = await loadAnalyzerModule();
+  module.setQueryCategory(row, category);
+}
+
 export function isWasmLoaded(): boolean {
   return analyzerModule !== null;
 }
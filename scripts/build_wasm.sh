@@ -20,29 +20,39 @@ fi
 echo "Setting up Emscripten environment..."
 source "$EMSDK_PATH/emsdk_env.sh"
 
-# Create build directory
-BUILD_DIR="../cpp/build"
-mkdir -p "$BUILD_DIR"
-
-# Navigate to build directory
-cd "$BUILD_DIR"
-
-# Clean previous build
-echo "Cleaning previous build..."
-rm -rf *
-
-# Run CMake with Emscripten toolchain
-echo "Running CMake..."
-python "$EMSDK_PATH/upstream/emscripten/emcmake.py" cmake ..
-
-# Build the project
-echo "Compiling to WASM..."
-python "$EMSDK_PATH/upstream/emscripten/emmake.py" ninja
+# One build per module variant (see TELLER_WASM_VARIANT in cpp/CMakeLists.txt);
+# the frontend picks the fastest one the browser supports
+for VARIANT in baseline simd simd-threads; do
+    if [ "$VARIANT" = "baseline" ]; then
+        BUILD_DIR="../cpp/build"
+    else
+        BUILD_DIR="../cpp/build-$VARIANT"
+    fi
+
+    # Create build directory
+    mkdir -p "$BUILD_DIR"
+    pushd "$BUILD_DIR" > /dev/null
+
+    # Clean previous build
+    echo "Cleaning previous $VARIANT build..."
+    rm -rf *
+
+    # Run CMake with Emscripten toolchain
+    echo "Running CMake ($VARIANT)..."
+    python "$EMSDK_PATH/upstream/emscripten/emcmake.py" cmake .. -DTELLER_WASM_VARIANT="$VARIANT"
+
+    # Build the project
+    echo "Compiling to WASM ($VARIANT)..."
+    python "$EMSDK_PATH/upstream/emscripten/emmake.py" ninja
+
+    popd > /dev/null
+done
 
 echo ""
 echo "✅ Build complete!"
 echo "📦 WASM files created at: frontend/public/wasm/"
-echo "   - bank_analyzer.js ($(du -h ../../frontend/public/wasm/bank_analyzer.js 2>/dev/null | cut -f1))"
-echo "   - bank_analyzer.wasm ($(du -h ../../frontend/public/wasm/bank_analyzer.wasm 2>/dev/null | cut -f1))"
+for FILE in bank_analyzer.wasm bank_analyzer.simd.wasm bank_analyzer.simd-threads.wasm; do
+    echo "   - $FILE ($(du -h ../frontend/public/wasm/$FILE 2>/dev/null | cut -f1))"
+done
 echo ""
 echo "Next step: cd frontend && npm run dev"
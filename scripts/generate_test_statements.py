@@ -219,8 +219,188 @@ def format_citibank_statement(transactions: List[Transaction],
 
     return "\n".join(output)
 
+# ============================================================================
+# BENCHMARK CORPUS (teller-bench)
+# ============================================================================
+# One layout per extraction pattern (see PATTERNS.md), emitted the way PDF.js
+# hands text to the extractor: items on a page joined by spaces, pages
+# separated by blank lines. Column gaps inside a row are kept so the
+# separate-column layouts (Patterns 4 and 8) still line up.
+
+ROWS_PER_PAGE = 30
+BENCH_PAGE_SIZES = [1, 10, 50, 100, 500]
+ADVERSARIAL_PAGE_SIZES = [1, 5]
+
+FRENCH_MONTHS = ['Janv', 'Févr', 'Mars', 'Avr', 'Mai', 'Juin',
+                 'Juil', 'Août', 'Sept', 'Oct', 'Nov', 'Dec']
+
+def money(value: float) -> str:
+    return f"{value:,.2f}"
+
+def french_money(value: float) -> str:
+    # 1 234,56 - space thousands separator, comma decimal
+    return f"{value:,.2f}".replace(',', ' ').replace('.', ',')
+
+def bench_rows_pattern1(txns):
+    rows, last_date = [], None
+    for t in txns:
+        date = t.date.strftime('%d %b')
+        prefix = '' if date == last_date else date + ' '
+        last_date = date
+        if t.type == 'credit':
+            rows.append(f"{prefix}Deposit {t.description.title()} {money(t.amount)} {money(t.balance)}")
+        else:
+            rows.append(f"{prefix}Purchase {t.description.title()} {money(t.amount)} {money(t.balance)}")
+    return rows
+
+def bench_rows_pattern2(txns):
+    rows = []
+    for t in txns:
+        post = t.date + datetime.timedelta(days=1)
+        amount = money(t.amount) if t.type == 'debit' else '-' + money(t.amount)
+        rows.append(f"{t.date.strftime('%b %d')} {post.strftime('%b %d')} {t.description} {amount}")
+    return rows
+
+def bench_rows_pattern3(txns):
+    rows = []
+    for t in txns:
+        amount = ('-$' if t.type == 'debit' else '$') + money(t.amount)
+        rows.append(f"{t.date.strftime('%m/%d/%Y')} {t.description} {amount} ${money(t.balance)} ")
+    return rows
+
+def bench_rows_pattern4(txns):
+    rows = []
+    for i, t in enumerate(txns):
+        check = str(1001 + i) if i % 4 == 0 else '****'
+        debit = money(t.amount) if t.type == 'debit' else ' '
+        credit = money(t.amount) if t.type == 'credit' else ' '
+        rows.append(f"{check} {t.date.strftime('%m/%d/%Y')} {t.description} {debit}  {credit}  {money(t.balance)}")
+    return rows
+
+def bench_rows_pattern5(txns):
+    rows = []
+    for t in txns:
+        amount = ('-' if t.type == 'debit' else '') + money(t.amount)
+        rows.append(f"{t.date.strftime('%Y-%m-%d')} {t.description} {amount}")
+    return rows
+
+def bench_rows_pattern6(txns):
+    rows = []
+    for i, t in enumerate(txns):
+        ref = f"REF{random.randint(100000, 999999)}{i % 10}"
+        amount = ('-$' if t.type == 'debit' else '$') + money(t.amount)
+        rows.append(f"{t.date.strftime('%m/%d/%Y')} {ref} {t.description} {amount} ${money(t.balance)} ")
+    return rows
+
+INVESTMENTS = [('AAPL', 'APPLE INC'), ('MSFT', 'MICROSOFT CORP'), ('VTI', 'VANGUARD TOTAL MKT'),
+               ('TD', 'TORONTO DOMINION BK'), ('XEQT', 'ISHARES CORE EQUITY')]
+
+def bench_rows_pattern7(txns):
+    rows = []
+    for t in txns:
+        symbol, name = random.choice(INVESTMENTS)
+        action = random.choice(['BUY', 'SELL', 'DIV', 'INT'])
+        quantity = random.randint(1, 50)
+        price = round(t.amount / quantity, 4)
+        settle = t.date + datetime.timedelta(days=2)
+        rows.append(f"{t.date.strftime('%m/%d/%Y')} {settle.strftime('%m/%d/%Y')} {symbol} {name} "
+                    f"{action} {quantity} {price:.4f} {money(quantity * price)}")
+    return rows
+
+def bench_rows_pattern8(txns):
+    rows = []
+    for t in txns:
+        date = f"{FRENCH_MONTHS[t.date.month - 1]} {t.date.day}"
+        debit = french_money(t.amount) if t.type == 'debit' else ' '
+        credit = french_money(t.amount) if t.type == 'credit' else ' '
+        rows.append(f"{date} {t.description} {debit}  {credit}  {french_money(t.balance)}")
+    return rows
+
+def bench_rows_pattern9(txns):
+    rows = []
+    for t in txns:
+        currency = random.choice(['USD', 'EUR', 'GBP'])
+        sign = '-' if t.type == 'debit' else ''
+        rows.append(f"{t.date.strftime('%m/%d/%Y')} {t.description} {sign}{money(t.amount)} "
+                    f"{currency} {sign}{money(t.amount * 1.36)}")
+    return rows
+
+def bench_rows_pattern10(txns):
+    return [f"{t.date.strftime('%b %d')} {t.description} {money(t.amount)}" for t in txns]
+
+BENCH_LAYOUTS = {
+    'pattern1_canadian': bench_rows_pattern1,
+    'pattern2_card': bench_rows_pattern2,
+    'pattern3_simple': bench_rows_pattern3,
+    'pattern4_check': bench_rows_pattern4,
+    'pattern5_minimal': bench_rows_pattern5,
+    'pattern6_reference': bench_rows_pattern6,
+    'pattern7_investment': bench_rows_pattern7,
+    'pattern8_bilingual': bench_rows_pattern8,
+    'pattern9_multicurrency': bench_rows_pattern9,
+    'pattern10_legacy': bench_rows_pattern10,
+}
+
+DISCLAIMER_WORDS = ('the bank is not responsible for any loss arising from unauthorized use of your card '
+                    'please review this statement carefully and report any discrepancy within thirty days '
+                    'interest is calculated on the daily closing balance and credited monthly to your account '
+                    'terms and conditions apply see your account agreement for details regarding fees').split()
+
+def adversarial_disclaimer_page() -> str:
+    # Prose with no amounts at all: every lazy description group scans to the end
+    return ' '.join(random.choice(DISCLAIMER_WORDS) for _ in range(500))
+
+def adversarial_numbers_page() -> str:
+    # Amount-like tokens with no dates: lots of near-misses for the amount groups
+    cells = []
+    for _ in range(400):
+        roll = random.random()
+        if roll < 0.7:
+            cells.append(money(random.uniform(0, 99999)))
+        elif roll < 0.85:
+            cells.append(str(random.randint(0, 99999)))
+        else:
+            cells.append(random.choice(['Rate', 'Yield', 'Total', 'Fee', 'Tier']))
+    return ' '.join(cells)
+
+def write_bench_corpus(output_dir: str, page_sizes: List[int], seed: int) -> None:
+    """Generate the teller-bench corpus: every layout at every page size, plus adversarial text"""
+    import os
+    os.makedirs(output_dir, exist_ok=True)
+    random.seed(seed)
+
+    for pages in page_sizes:
+        txns = generate_transactions(pages * ROWS_PER_PAGE, datetime.date(2024, 1, 1))
+        for layout, rows_for in BENCH_LAYOUTS.items():
+            rows = rows_for(txns)
+            page_texts = [' '.join(rows[p * ROWS_PER_PAGE:(p + 1) * ROWS_PER_PAGE]) for p in range(pages)]
+            path = os.path.join(output_dir, f"{layout}_{pages}p.txt")
+            with open(path, 'w', encoding='utf-8') as f:
+                f.write('\n\n'.join(page_texts) + '\n\n')
+            print(f"Generated: {path}")
+
+    for pages in ADVERSARIAL_PAGE_SIZES:
+        for layout, page_for in (('adversarial_disclaimer', adversarial_disclaimer_page),
+                                 ('adversarial_numbers', adversarial_numbers_page)):
+            path = os.path.join(output_dir, f"{layout}_{pages}p.txt")
+            with open(path, 'w', encoding='utf-8') as f:
+                f.write('\n\n'.join(page_for() for _ in range(pages)) + '\n\n')
+            print(f"Generated: {path}")
+
 def main():
     """Generate sample statements for all major NA banks"""
+    import argparse
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('--bench-corpus', metavar='DIR',
+                        help='generate the teller-bench corpus into DIR instead of the sample statements')
+    parser.add_argument('--pages', type=int, nargs='+', default=BENCH_PAGE_SIZES,
+                        help='page counts for the bench corpus (default: %(default)s)')
+    parser.add_argument('--seed', type=int, default=42, help='random seed for the bench corpus')
+    args = parser.parse_args()
+
+    if args.bench_corpus:
+        write_bench_corpus(args.bench_corpus, args.pages, args.seed)
+        return
 
     # Generate transaction data
     start_date = datetime.date(2024, 1, 1)